@@ -1,17 +1,40 @@
 #pragma once
 
 #include <array>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <span>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
+#include <variant>
 #include <vector>
 
 #include <js.h>
 #include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
 #include <utf.h>
+#include <uv.h>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
 
 #ifndef NDEBUG
 static constexpr bool js_is_debug = true;
@@ -109,6 +132,18 @@ struct js_arraybuffer_t : js_object_t {
   js_arraybuffer_t(js_value_t *value) : js_object_t(value) {}
 };
 
+struct js_sharedarraybuffer_t : js_object_t {
+  js_sharedarraybuffer_t() : js_object_t() {}
+
+  js_sharedarraybuffer_t(js_value_t *value) : js_object_t(value) {}
+};
+
+struct js_dataview_t : js_object_t {
+  js_dataview_t() : js_object_t() {}
+
+  js_dataview_t(js_value_t *value) : js_object_t(value) {}
+};
+
 template <typename T>
 struct js_typedarray_t : js_object_t {
   js_typedarray_t() : js_object_t() {}
@@ -116,6 +151,18 @@ struct js_typedarray_t : js_object_t {
   js_typedarray_t(js_value_t *value) : js_object_t(value) {}
 };
 
+struct js_typedarray_any_t : js_object_t {
+  js_typedarray_any_t() : js_object_t() {}
+
+  js_typedarray_any_t(js_value_t *value) : js_object_t(value) {}
+};
+
+struct js_arraybuffer_view_t : js_object_t {
+  js_arraybuffer_view_t() : js_object_t() {}
+
+  js_arraybuffer_view_t(js_value_t *value) : js_object_t(value) {}
+};
+
 struct js_receiver_t : js_handle_t {
   js_receiver_t() : js_handle_t() {}
 
@@ -137,6 +184,13 @@ struct js_external_t : js_handle_t {
   js_external_t(js_value_t *value) : js_handle_t(value) {}
 };
 
+template <typename T>
+struct js_class_t : js_object_t {
+  js_class_t() : js_object_t() {}
+
+  js_class_t(js_value_t *value) : js_object_t(value) {}
+};
+
 template <typename T>
 struct js_persistent_t {
   js_env_t *env;
@@ -156,10 +210,324 @@ struct js_persistent_t {
     assert(err == 0);
   }
 
+  js_persistent_t &
+  operator=(js_persistent_t &&that) {
+    std::swap(env, that.env);
+    std::swap(ref, that.ref);
+
+    return *this;
+  }
+
   void
   operator=(const js_persistent_t &) = delete;
 };
 
+struct js_reference_pool_t {
+  js_env_t *env;
+  js_ref_t *ref;
+  std::deque<uint32_t> free;
+  std::vector<bool> used;
+  uint32_t len;
+
+  js_reference_pool_t() : env(nullptr), ref(nullptr), free(), used(), len(0) {}
+
+  js_reference_pool_t(js_reference_pool_t &&that) : env(that.env), ref(std::exchange(that.ref, nullptr)), free(std::move(that.free)), used(std::move(that.used)), len(std::exchange(that.len, 0)) {}
+
+  js_reference_pool_t(const js_reference_pool_t &) = delete;
+
+  ~js_reference_pool_t() {
+    if (ref == nullptr) return;
+
+    int err;
+    err = js_delete_reference(env, ref);
+    assert(err == 0);
+  }
+
+  js_reference_pool_t &
+  operator=(js_reference_pool_t &&that) {
+    std::swap(env, that.env);
+    std::swap(ref, that.ref);
+    std::swap(free, that.free);
+    std::swap(used, that.used);
+    std::swap(len, that.len);
+
+    return *this;
+  }
+
+  void
+  operator=(const js_reference_pool_t &) = delete;
+};
+
+struct js_typedarray_pool_t {
+  static constexpr size_t default_size = 8192;
+  static constexpr size_t default_cutoff = default_size / 2;
+  static constexpr size_t alignment = 8;
+
+  js_persistent_t<js_arraybuffer_t> slab;
+  uint8_t *data;
+  size_t size;
+  size_t cutoff;
+  size_t offset;
+
+  js_typedarray_pool_t() : slab(), data(nullptr), size(default_size), cutoff(default_cutoff), offset(default_size) {}
+
+  js_typedarray_pool_t(size_t size, size_t cutoff) : slab(), data(nullptr), size(size), cutoff(cutoff), offset(size) {
+    assert(cutoff <= size);
+  }
+};
+
+template <typename T>
+struct js_handle_table_t {
+  static constexpr uint32_t index_bits = 24;
+  static constexpr uint32_t index_mask = (1u << index_bits) - 1;
+  static constexpr uint8_t generation_max = std::numeric_limits<uint8_t>::max();
+
+  js_reference_pool_t pool;
+  std::vector<uint8_t> generations;
+
+  js_handle_table_t() : pool(), generations() {}
+
+  js_handle_table_t(js_handle_table_t &&that) = default;
+
+  js_handle_table_t(const js_handle_table_t &) = delete;
+
+  js_handle_table_t &
+  operator=(js_handle_table_t &&that) = default;
+
+  void
+  operator=(const js_handle_table_t &) = delete;
+};
+
+template <typename K, typename T>
+struct js_weak_cache_t {
+  struct entry_t {
+    js_persistent_t<T> reference;
+    uint64_t id;
+  };
+
+  struct state_t {
+    std::unordered_map<K, entry_t> entries;
+    uint64_t id = 0;
+  };
+
+  struct eviction_t {
+    std::weak_ptr<state_t> state;
+    K key;
+    uint64_t id;
+  };
+
+  std::shared_ptr<state_t> state;
+
+  js_weak_cache_t() : state(std::make_shared<state_t>()) {}
+
+  js_weak_cache_t(js_weak_cache_t &&that) = default;
+
+  js_weak_cache_t(const js_weak_cache_t &) = delete;
+
+  js_weak_cache_t &
+  operator=(js_weak_cache_t &&that) = default;
+
+  void
+  operator=(const js_weak_cache_t &) = delete;
+
+  static void
+  evict(js_env_t *, void *data, void *) {
+    auto eviction = static_cast<eviction_t *>(data);
+
+    if (auto state = eviction->state.lock()) {
+      auto entry = state->entries.find(eviction->key);
+
+      if (entry != state->entries.end() && entry->second.id == eviction->id) {
+        state->entries.erase(entry);
+      }
+    }
+
+    delete eviction;
+  }
+};
+
+struct js_external_memory_t {
+  js_env_t *env;
+  int64_t size;
+
+  js_external_memory_t() : env(nullptr), size(0) {}
+
+  js_external_memory_t(js_env_t *env, size_t size) : env(env), size(int64_t(size)) {
+    if (size == 0) return;
+
+    int err;
+    err = js_adjust_external_memory(env, this->size, nullptr);
+    assert(err == 0);
+  }
+
+  js_external_memory_t(js_external_memory_t &&that) : env(that.env), size(std::exchange(that.size, 0)) {}
+
+  js_external_memory_t(const js_external_memory_t &) = delete;
+
+  ~js_external_memory_t() {
+    if (size == 0) return;
+
+    int err;
+    err = js_adjust_external_memory(env, -size, nullptr);
+    assert(err == 0);
+  }
+
+  js_external_memory_t &
+  operator=(js_external_memory_t &&that) {
+    std::swap(env, that.env);
+    std::swap(size, that.size);
+
+    return *this;
+  }
+
+  void
+  operator=(const js_external_memory_t &) = delete;
+};
+
+struct js_backing_store_owner_t {
+  static inline std::atomic<size_t> live = 0;
+
+  js_env_t *env;
+  std::thread::id thread;
+  std::mutex lock;
+  js_arraybuffer_backing_store_t *backing_store;
+  uv_async_t async;
+  bool dropped;
+  bool dead;
+  int refs;
+
+  js_backing_store_owner_t(js_env_t *env, js_arraybuffer_backing_store_t *backing_store) : env(env), thread(std::this_thread::get_id()), backing_store(backing_store), dropped(false), dead(false), refs(2) {
+    live++;
+  }
+
+  void
+  release(bool teardown) {
+    int err;
+
+    err = js_release_arraybuffer_backing_store(env, backing_store);
+    assert(err == 0);
+
+    backing_store = nullptr;
+
+    live--;
+
+    if (!teardown) {
+      err = js_remove_teardown_callback(env, on_teardown, this);
+      assert(err == 0);
+    }
+
+    dead = true;
+
+    uv_close(reinterpret_cast<uv_handle_t *>(&async), on_close);
+  }
+
+  static void
+  unref(js_backing_store_owner_t *owner) {
+    bool last;
+
+    {
+      std::lock_guard guard(owner->lock);
+
+      last = --owner->refs == 0;
+    }
+
+    if (last) delete owner;
+  }
+
+  static void
+  on_async(uv_async_t *handle) {
+    auto owner = static_cast<js_backing_store_owner_t *>(handle->data);
+
+    std::lock_guard guard(owner->lock);
+
+    if (owner->dropped && !owner->dead) owner->release(false);
+  }
+
+  static void
+  on_teardown(void *data) {
+    auto owner = static_cast<js_backing_store_owner_t *>(data);
+
+    std::lock_guard guard(owner->lock);
+
+    if (!owner->dead) owner->release(true);
+  }
+
+  static void
+  on_close(uv_handle_t *handle) {
+    unref(static_cast<js_backing_store_owner_t *>(handle->data));
+  }
+};
+
+struct js_backing_store_release_t {
+  js_backing_store_owner_t *owner;
+
+  void
+  operator()(js_arraybuffer_backing_store_t *) const {
+    int err;
+
+    {
+      std::lock_guard guard(owner->lock);
+
+      if (!owner->dead) {
+        owner->dropped = true;
+
+        if (std::this_thread::get_id() == owner->thread) {
+          owner->release(false);
+        } else {
+          err = uv_async_send(&owner->async);
+          assert(err == 0);
+        }
+      }
+    }
+
+    js_backing_store_owner_t::unref(owner);
+  }
+};
+
+static inline int
+js_own_backing_store(js_env_t *env, js_arraybuffer_backing_store_t *backing_store, std::shared_ptr<js_arraybuffer_backing_store_t> &result) {
+  int err;
+
+  uv_loop_t *loop;
+  err = js_get_env_loop(env, &loop);
+
+  if (err < 0) {
+    js_release_arraybuffer_backing_store(env, backing_store);
+
+    return err;
+  }
+
+  auto owner = new js_backing_store_owner_t(env, backing_store);
+
+  err = uv_async_init(loop, &owner->async, js_backing_store_owner_t::on_async);
+  assert(err == 0);
+
+  owner->async.data = owner;
+
+  uv_unref(reinterpret_cast<uv_handle_t *>(&owner->async));
+
+  err = js_add_teardown_callback(env, js_backing_store_owner_t::on_teardown, owner);
+  assert(err == 0);
+
+  result = std::shared_ptr<js_arraybuffer_backing_store_t>(backing_store, js_backing_store_release_t{owner});
+
+  return 0;
+}
+
+template <typename T>
+struct js_transfer_t;
+
+template <typename T>
+struct js_transfer_t<std::span<T>> {
+  std::span<T> value;
+  std::shared_ptr<js_arraybuffer_backing_store_t> backing_store;
+  js_arraybuffer_t arraybuffer;
+
+  operator std::span<T>() const {
+    return value;
+  }
+};
+
 template <int check(js_env_t *, js_value_t *, bool *result)>
 static inline int
 js_check_value(js_env_t *env, js_value_t *value, const char *label) {
@@ -323,87 +691,386 @@ js_is_typedarray(js_env_t *env, const js_handle_t &value, bool &result) {
   return js_typedarray_info_t<T>::is(env, value, result);
 }
 
-template <typename T>
-struct js_type_info_t;
+static constexpr size_t
+js_typedarray_element_size(js_typedarray_type_t type) {
+  switch (type) {
+  case js_int8array:
+  case js_uint8array:
+  case js_uint8clampedarray:
+    return 1;
+  case js_int16array:
+  case js_uint16array:
+  case js_float16array:
+    return 2;
+  case js_int32array:
+  case js_uint32array:
+  case js_float32array:
+    return 4;
+  case js_float64array:
+  case js_bigint64array:
+  case js_biguint64array:
+    return 8;
+  }
 
-template <>
-struct js_type_info_t<void> {
-  using type = void;
+  return 1;
+}
 
-  static constexpr auto signature = js_undefined;
+static inline int
+js_is_arraybuffer_view(js_env_t *env, js_value_t *value, bool *result) {
+  int err;
+  err = js_is_typedarray(env, value, result);
+  if (err < 0) return err;
 
-  template <bool checked>
-  static auto
-  marshall(js_env_t *env, js_value_t *&result) {
-    return js_get_undefined(env, &result);
+  if (*result) return 0;
+
+  return js_is_dataview(env, value, result);
+}
+
+template <typename T>
+static constexpr T
+js_byteswap(T value) {
+  auto bytes = std::bit_cast<std::array<uint8_t, sizeof(T)>>(value);
+
+  for (size_t i = 0, j = sizeof(T) - 1; i < j; i++, j--) {
+    std::swap(bytes[i], bytes[j]);
   }
+
+  return std::bit_cast<T>(bytes);
+}
+
+template <typename T, std::endian endian = std::endian::big>
+struct js_field_t {
+  using type = T;
+
+  static constexpr auto byte_order = endian;
 };
 
-template <>
-struct js_type_info_t<bool> {
-  using type = bool;
+template <typename... F>
+struct js_record_view_t {
+  static constexpr std::array<size_t, sizeof...(F)> sizes = {sizeof(typename F::type)...};
 
-  static constexpr auto signature = js_boolean;
+  static constexpr auto offsets = [] {
+    std::array<size_t, sizeof...(F)> offsets{};
 
-  static auto
-  marshall(bool value, bool &result) {
-    result = value;
+    for (size_t i = 1; i < sizes.size(); i++) {
+      offsets[i] = offsets[i - 1] + sizes[i - 1];
+    }
 
-    return 0;
-  }
+    return offsets;
+  }();
 
-  template <bool checked>
-  static auto
-  marshall(js_env_t *, bool value, bool &result) {
-    return marshall(value, result);
-  }
+  static constexpr size_t size = (sizeof(typename F::type) + ... + 0);
 
-  template <bool checked>
-  static auto
-  marshall(js_env_t *env, bool value, js_value_t *&result) {
-    return js_get_boolean(env, value, &result);
-  }
+  template <size_t I>
+  using field = std::tuple_element_t<I, std::tuple<F...>>;
 
-  static auto
-  unmarshall(bool value, bool &result) {
-    result = value;
+  uint8_t *data;
 
-    return 0;
+  js_record_view_t() : data(nullptr) {}
+
+  js_record_view_t(std::span<uint8_t> data) : data(data.data()) {
+    assert(data.size() >= size);
   }
 
-  template <bool checked>
-  static auto
-  unmarshall(js_env_t *, bool value, bool &result) {
-    return unmarshall(value, result);
+  template <size_t I>
+  auto
+  get() const {
+    using T = typename field<I>::type;
+
+    T value;
+    memcpy(&value, data + offsets[I], sizeof(T));
+
+    if constexpr (field<I>::byte_order != std::endian::native) value = js_byteswap(value);
+
+    return value;
   }
 
-  template <bool checked>
-  static auto
-  unmarshall(js_env_t *env, js_value_t *value, bool &result) {
-    if constexpr (checked) {
-      int err;
-      err = js_check_value<js_is_boolean>(env, value, "boolean");
-      if (err < 0) return err;
-    }
+  template <size_t I>
+  void
+  set(typename field<I>::type value) {
+    if constexpr (field<I>::byte_order != std::endian::native) value = js_byteswap(value);
 
-    return js_get_value_bool(env, value, &result);
+    memcpy(data + offsets[I], &value, sizeof(value));
   }
 };
 
-template <>
-struct js_type_info_t<int32_t> {
-  using type = int32_t;
+template <typename D, typename S, bool clamp>
+static inline D
+js_convert_value(S value) {
+  if constexpr (clamp && std::is_integral_v<D> && !std::is_same_v<D, S>) {
+    using limits = std::numeric_limits<D>;
 
-  static constexpr auto signature = js_int32;
+    if constexpr (std::is_floating_point_v<S>) {
+      if (value != value) return D(0);
+      if (value <= S(limits::min())) return limits::min();
+      if (value >= S(limits::max())) return limits::max();
 
-  static auto
-  marshall(int32_t value, int32_t &result) {
-    result = value;
+      return D(std::nearbyint(value));
+    } else {
+      if (std::cmp_less(value, limits::min())) return limits::min();
+      if (std::cmp_greater(value, limits::max())) return limits::max();
 
-    return 0;
-  }
+      return D(value);
+    }
+  } else if constexpr (std::is_integral_v<D> && std::is_floating_point_v<S>) {
+    using U = std::make_unsigned_t<D>;
 
-  template <bool checked>
+    if (!std::isfinite(value)) return D(0);
+
+    auto modulus = std::ldexp(S(1), std::numeric_limits<U>::digits);
+
+    auto wrapped = std::fmod(std::trunc(value), modulus);
+
+    return D(wrapped < 0 ? U(0) - U(-wrapped) : U(wrapped));
+  } else {
+    return D(value);
+  }
+}
+
+template <size_t N>
+static constexpr auto
+js_byteswap_mask() {
+  std::array<uint8_t, 32> mask{};
+
+  for (size_t i = 0; i < mask.size(); i++) {
+    mask[i] = uint8_t((i % 16) / N * N + (N - 1 - i % N));
+  }
+
+  return mask;
+}
+
+template <typename D, typename S, bool clamp, std::endian endian>
+static inline size_t
+js_convert_vectorized(const S *src, D *dst, size_t len) {
+  size_t i = 0;
+
+  if constexpr (std::is_same_v<S, double> && std::is_same_v<D, float> && endian == std::endian::native) {
+#if defined(__AVX__)
+    for (; i + 4 <= len; i += 4) {
+      _mm_storeu_ps(dst + i, _mm256_cvtpd_ps(_mm256_loadu_pd(src + i)));
+    }
+#endif
+#if defined(__SSE2__)
+    for (; i + 2 <= len; i += 2) {
+      _mm_storel_pi((__m64 *) (dst + i), _mm_cvtpd_ps(_mm_loadu_pd(src + i)));
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    for (; i + 2 <= len; i += 2) {
+      vst1_f32(dst + i, vcvt_f32_f64(vld1q_f64(src + i)));
+    }
+#endif
+  } else if constexpr (std::is_same_v<S, int32_t> && std::is_same_v<D, uint8_t> && clamp && endian == std::endian::native) {
+#if defined(__AVX2__)
+    for (; i + 16 <= len; i += 16) {
+      auto a = _mm256_loadu_si256((const __m256i *) (src + i));
+      auto b = _mm256_loadu_si256((const __m256i *) (src + i + 8));
+      auto words = _mm256_permute4x64_epi64(_mm256_packs_epi32(a, b), 0xd8);
+      auto bytes = _mm_packus_epi16(_mm256_castsi256_si128(words), _mm256_extracti128_si256(words, 1));
+      _mm_storeu_si128((__m128i *) (dst + i), bytes);
+    }
+#endif
+#if defined(__SSE2__)
+    for (; i + 8 <= len; i += 8) {
+      auto a = _mm_loadu_si128((const __m128i *) (src + i));
+      auto b = _mm_loadu_si128((const __m128i *) (src + i + 4));
+      auto words = _mm_packs_epi32(a, b);
+      _mm_storel_epi64((__m128i *) (dst + i), _mm_packus_epi16(words, words));
+    }
+#elif defined(__ARM_NEON)
+    for (; i + 8 <= len; i += 8) {
+      auto words = vcombine_u16(vqmovun_s32(vld1q_s32(src + i)), vqmovun_s32(vld1q_s32(src + i + 4)));
+      vst1_u8(dst + i, vqmovn_u16(words));
+    }
+#endif
+  } else if constexpr (std::is_same_v<S, D> && sizeof(S) > 1 && endian != std::endian::native) {
+#if defined(__AVX2__) || defined(__SSSE3__) || defined(__ARM_NEON)
+    constexpr auto n = 16 / sizeof(S);
+#endif
+#if defined(__AVX2__) || defined(__SSSE3__)
+    static constexpr auto mask = js_byteswap_mask<sizeof(S)>();
+#endif
+#if defined(__AVX2__)
+    auto mask256 = _mm256_loadu_si256((const __m256i *) mask.data());
+
+    for (; i + 2 * n <= len; i += 2 * n) {
+      auto value = _mm256_loadu_si256((const __m256i *) (src + i));
+      _mm256_storeu_si256((__m256i *) (dst + i), _mm256_shuffle_epi8(value, mask256));
+    }
+#endif
+#if defined(__SSSE3__)
+    auto mask128 = _mm_loadu_si128((const __m128i *) mask.data());
+
+    for (; i + n <= len; i += n) {
+      auto value = _mm_loadu_si128((const __m128i *) (src + i));
+      _mm_storeu_si128((__m128i *) (dst + i), _mm_shuffle_epi8(value, mask128));
+    }
+#elif defined(__ARM_NEON)
+    for (; i + n <= len; i += n) {
+      auto value = vld1q_u8((const uint8_t *) (src + i));
+
+      if constexpr (sizeof(S) == 2) value = vrev16q_u8(value);
+      else if constexpr (sizeof(S) == 4) value = vrev32q_u8(value);
+      else value = vrev64q_u8(value);
+
+      vst1q_u8((uint8_t *) (dst + i), value);
+    }
+#endif
+  }
+
+  return i;
+}
+
+template <typename D, bool clamp = false, std::endian endian = std::endian::native, typename S>
+static inline void
+js_convert(const S *src, D *dst, size_t len) {
+  if constexpr (std::is_same_v<S, D> && (endian == std::endian::native || sizeof(S) == 1)) {
+    std::copy(src, src + len, dst);
+  } else {
+    auto i = js_convert_vectorized<D, S, clamp, endian>(src, dst, len);
+
+    for (; i < len; i++) {
+      auto value = src[i];
+
+      if constexpr (endian != std::endian::native) value = js_byteswap(value);
+
+      dst[i] = js_convert_value<D, S, clamp>(value);
+    }
+  }
+}
+
+template <typename D, bool clamp = false, std::endian endian = std::endian::native, typename S>
+static inline void
+js_convert(std::span<S> src, std::span<D> dst) {
+  assert(dst.size() >= src.size());
+
+  js_convert<D, clamp, endian>(src.data(), dst.data(), src.size());
+}
+
+static inline bool
+js_is_ascii(const char *data, size_t len) {
+  size_t i = 0;
+
+#if defined(__AVX2__)
+  for (; i + 32 <= len; i += 32) {
+    if (_mm256_movemask_epi8(_mm256_loadu_si256((const __m256i *) (data + i))) != 0) return false;
+  }
+#endif
+#if defined(__SSE2__)
+  for (; i + 16 <= len; i += 16) {
+    if (_mm_movemask_epi8(_mm_loadu_si128((const __m128i *) (data + i))) != 0) return false;
+  }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+  for (; i + 16 <= len; i += 16) {
+    if (vmaxvq_u8(vld1q_u8((const uint8_t *) (data + i))) >= 0x80) return false;
+  }
+#endif
+
+  for (; i < len; i++) {
+    if (uint8_t(data[i]) >= 0x80) return false;
+  }
+
+  return true;
+}
+
+static inline auto
+js_create_string_ascii_or_utf8(js_env_t *env, const char *value, size_t len, js_value_t **result) {
+  if (js_is_ascii(value, len)) {
+    return js_create_string_latin1(env, (const latin1_t *) value, len, result);
+  }
+
+  return js_create_string_utf8(env, (const utf8_t *) value, len, result);
+}
+
+template <typename D, typename S, bool clamp = false, std::endian endian = std::endian::native>
+struct js_typedarray_conversion_t {
+  std::vector<D> value;
+
+  operator std::span<const D>() const {
+    return value;
+  }
+};
+
+template <typename T>
+struct js_type_info_t;
+
+template <>
+struct js_type_info_t<void> {
+  using type = void;
+
+  static constexpr auto signature = js_undefined;
+
+  template <bool checked>
+  static auto
+  marshall(js_env_t *env, js_value_t *&result) {
+    return js_get_undefined(env, &result);
+  }
+};
+
+template <>
+struct js_type_info_t<bool> {
+  using type = bool;
+
+  static constexpr auto signature = js_boolean;
+
+  static auto
+  marshall(bool value, bool &result) {
+    result = value;
+
+    return 0;
+  }
+
+  template <bool checked>
+  static auto
+  marshall(js_env_t *, bool value, bool &result) {
+    return marshall(value, result);
+  }
+
+  template <bool checked>
+  static auto
+  marshall(js_env_t *env, bool value, js_value_t *&result) {
+    return js_get_boolean(env, value, &result);
+  }
+
+  static auto
+  unmarshall(bool value, bool &result) {
+    result = value;
+
+    return 0;
+  }
+
+  template <bool checked>
+  static auto
+  unmarshall(js_env_t *, bool value, bool &result) {
+    return unmarshall(value, result);
+  }
+
+  template <bool checked>
+  static auto
+  unmarshall(js_env_t *env, js_value_t *value, bool &result) {
+    if constexpr (checked) {
+      int err;
+      err = js_check_value<js_is_boolean>(env, value, "boolean");
+      if (err < 0) return err;
+    }
+
+    return js_get_value_bool(env, value, &result);
+  }
+};
+
+template <>
+struct js_type_info_t<int32_t> {
+  using type = int32_t;
+
+  static constexpr auto signature = js_int32;
+
+  static auto
+  marshall(int32_t value, int32_t &result) {
+    result = value;
+
+    return 0;
+  }
+
+  template <bool checked>
   static auto
   marshall(js_env_t *, int32_t value, int32_t &result) {
     return marshall(value, result);
@@ -623,1000 +1290,4023 @@ struct js_type_info_t<js_bigint_t> {
   }
 };
 
+template <typename T>
+struct js_bigint_value_t {
+  T value;
+
+  js_bigint_value_t() : value() {}
+
+  js_bigint_value_t(T value) : value(value) {}
+
+  operator T() const {
+    return value;
+  }
+};
+
 template <>
-struct js_type_info_t<js_string_t> {
+struct js_type_info_t<js_bigint_value_t<int64_t>> {
   using type = js_value_t *;
 
-  static constexpr auto signature = js_string;
+  static constexpr auto signature = js_bigint;
 
   template <bool checked>
   static auto
-  marshall(js_env_t *, const js_string_t &string, js_value_t *&result) {
-    result = string.value;
-
-    return 0;
+  marshall(js_env_t *env, const js_bigint_value_t<int64_t> &value, js_value_t *&result) {
+    return js_create_bigint_int64(env, value.value, &result);
   }
 
   template <bool checked>
-  static auto
-  unmarshall(js_env_t *env, js_value_t *value, js_string_t &result) {
+  static int
+  unmarshall(js_env_t *env, js_value_t *value, js_bigint_value_t<int64_t> &result) {
+    int err;
+
     if constexpr (checked) {
-      int err;
-      err = js_check_value<js_is_string>(env, value, "string");
+      err = js_check_value<js_is_bigint>(env, value, "bigint");
       if (err < 0) return err;
     }
 
-    result = js_string_t(value);
+    bool lossless;
+    err = js_get_value_bigint_int64(env, value, &result.value, &lossless);
+    if (err < 0) return err;
+
+    if constexpr (checked) {
+      if (!lossless) {
+        err = js_throw_range_error(env, nullptr, "BigInt does not fit in 'int64'");
+        assert(err == 0);
+
+        return js_pending_exception;
+      }
+    }
 
     return 0;
   }
 };
 
 template <>
-struct js_type_info_t<js_symbol_t> {
+struct js_type_info_t<js_bigint_value_t<uint64_t>> {
   using type = js_value_t *;
 
-  static constexpr auto signature = js_symbol;
+  static constexpr auto signature = js_bigint;
 
   template <bool checked>
   static auto
-  marshall(js_env_t *, const js_symbol_t &symbol, js_value_t *&result) {
-    result = symbol.value;
-
-    return 0;
+  marshall(js_env_t *env, const js_bigint_value_t<uint64_t> &value, js_value_t *&result) {
+    return js_create_bigint_uint64(env, value.value, &result);
   }
 
   template <bool checked>
-  static auto
-  unmarshall(js_env_t *env, js_value_t *value, js_symbol_t &result) {
+  static int
+  unmarshall(js_env_t *env, js_value_t *value, js_bigint_value_t<uint64_t> &result) {
+    int err;
+
     if constexpr (checked) {
-      int err;
-      err = js_check_value<js_is_symbol>(env, value, "symbol");
+      err = js_check_value<js_is_bigint>(env, value, "bigint");
       if (err < 0) return err;
     }
 
-    result = js_symbol_t(value);
+    bool lossless;
+    err = js_get_value_bigint_uint64(env, value, &result.value, &lossless);
+    if (err < 0) return err;
+
+    if constexpr (checked) {
+      if (!lossless) {
+        err = js_throw_range_error(env, nullptr, "BigInt does not fit in 'uint64'");
+        assert(err == 0);
+
+        return js_pending_exception;
+      }
+    }
 
     return 0;
   }
 };
 
-template <>
-struct js_type_info_t<js_object_t> {
+template <typename T>
+struct js_bigint128_type_info_t {
   using type = js_value_t *;
 
-  static constexpr auto signature = js_object;
+  static constexpr auto signature = js_bigint;
+
+  static constexpr bool is_signed = T(-1) < T(0);
 
   template <bool checked>
   static auto
-  marshall(js_env_t *, const js_object_t &object, js_value_t *&result) {
-    result = object.value;
+  marshall(js_env_t *env, const js_bigint_value_t<T> &value, js_value_t *&result) {
+    auto negative = is_signed && value.value < 0;
 
-    return 0;
+    auto magnitude = negative ? -(unsigned __int128) value.value : (unsigned __int128) value.value;
+
+    uint64_t words[2] = {uint64_t(magnitude), uint64_t(magnitude >> 64)};
+
+    return js_create_bigint_words(env, negative ? 1 : 0, words, words[1] == 0 ? 1 : 2, &result);
   }
 
   template <bool checked>
-  static auto
-  unmarshall(js_env_t *env, js_value_t *value, js_object_t &result) {
+  static int
+  unmarshall(js_env_t *env, js_value_t *value, js_bigint_value_t<T> &result) {
+    int err;
+
     if constexpr (checked) {
-      int err;
-      err = js_check_value<js_is_object>(env, value, "object");
+      err = js_check_value<js_is_bigint>(env, value, "bigint");
       if (err < 0) return err;
     }
 
-    result = js_object_t(value);
+    int sign;
+    uint64_t words[2] = {0, 0};
+    size_t len;
+    err = js_get_value_bigint_words(env, value, &sign, words, 2, &len);
+    if (err < 0) return err;
+
+    auto magnitude = (unsigned __int128) words[1] << 64 | words[0];
+
+    if constexpr (checked) {
+      auto limit = is_signed ? ((unsigned __int128) 1 << 127) - (sign ? 0 : 1) : ~(unsigned __int128) 0;
+
+      if (len > 2 || magnitude > limit || (!is_signed && sign && magnitude != 0)) {
+        err = js_throw_range_error(env, nullptr, is_signed ? "BigInt does not fit in 'int128'" : "BigInt does not fit in 'uint128'");
+        assert(err == 0);
+
+        return js_pending_exception;
+      }
+    }
+
+    result.value = sign ? T(-magnitude) : T(magnitude);
 
     return 0;
   }
 };
 
 template <>
-struct js_type_info_t<js_array_t> {
+struct js_type_info_t<js_bigint_value_t<__int128>> : js_bigint128_type_info_t<__int128> {};
+
+template <>
+struct js_type_info_t<js_bigint_value_t<unsigned __int128>> : js_bigint128_type_info_t<unsigned __int128> {};
+
+template <>
+struct js_type_info_t<js_string_t> {
   using type = js_value_t *;
 
-  static constexpr auto signature = js_object;
+  static constexpr auto signature = js_string;
 
   template <bool checked>
   static auto
-  marshall(js_env_t *, const js_array_t &array, js_value_t *&result) {
-    result = array.value;
+  marshall(js_env_t *, const js_string_t &string, js_value_t *&result) {
+    result = string.value;
 
     return 0;
   }
 
   template <bool checked>
   static auto
-  unmarshall(js_env_t *env, js_value_t *value, js_array_t &result) {
+  unmarshall(js_env_t *env, js_value_t *value, js_string_t &result) {
     if constexpr (checked) {
       int err;
-      err = js_check_value<js_is_array>(env, value, "array");
+      err = js_check_value<js_is_string>(env, value, "string");
       if (err < 0) return err;
     }
 
-    result = js_array_t(value);
+    result = js_string_t(value);
 
     return 0;
   }
 };
 
 template <>
-struct js_type_info_t<js_arraybuffer_t> {
+struct js_type_info_t<js_symbol_t> {
   using type = js_value_t *;
 
-  static constexpr auto signature = js_object;
+  static constexpr auto signature = js_symbol;
 
   template <bool checked>
   static auto
-  marshall(js_env_t *, const js_arraybuffer_t &arraybuffer, js_value_t *&result) {
-    result = arraybuffer.value;
+  marshall(js_env_t *, const js_symbol_t &symbol, js_value_t *&result) {
+    result = symbol.value;
 
     return 0;
   }
 
   template <bool checked>
   static auto
-  unmarshall(js_env_t *env, js_value_t *value, js_arraybuffer_t &result) {
+  unmarshall(js_env_t *env, js_value_t *value, js_symbol_t &result) {
     if constexpr (checked) {
       int err;
-      err = js_check_value<js_is_arraybuffer>(env, value, "arraybuffer");
+      err = js_check_value<js_is_symbol>(env, value, "symbol");
       if (err < 0) return err;
     }
 
-    result = js_arraybuffer_t(value);
+    result = js_symbol_t(value);
 
     return 0;
   }
 };
 
-template <typename T>
-struct js_type_info_t<js_typedarray_t<T>> {
+template <>
+struct js_type_info_t<js_object_t> {
   using type = js_value_t *;
 
   static constexpr auto signature = js_object;
 
   template <bool checked>
   static auto
-  marshall(js_env_t *, const js_typedarray_t<T> &typedarray, js_value_t *&result) {
-    result = typedarray.value;
+  marshall(js_env_t *, const js_object_t &object, js_value_t *&result) {
+    result = object.value;
 
     return 0;
   }
 
   template <bool checked>
   static auto
-  unmarshall(js_env_t *env, js_value_t *value, js_typedarray_t<T> &result) {
+  unmarshall(js_env_t *env, js_value_t *value, js_object_t &result) {
     if constexpr (checked) {
       int err;
-      err = js_check_value<js_is_typedarray<T>>(env, value, js_typedarray_info_t<T>::label);
+      err = js_check_value<js_is_object>(env, value, "object");
       if (err < 0) return err;
     }
 
-    result = js_typedarray_t<T>(value);
+    result = js_object_t(value);
 
     return 0;
   }
 };
 
 template <>
-struct js_type_info_t<js_receiver_t> {
+struct js_type_info_t<js_array_t> {
   using type = js_value_t *;
 
   static constexpr auto signature = js_object;
 
+  template <bool checked>
   static auto
-  marshall(const js_receiver_t &receiver, js_value_t *&result) {
-    result = receiver.value;
+  marshall(js_env_t *, const js_array_t &array, js_value_t *&result) {
+    result = array.value;
 
     return 0;
   }
 
   template <bool checked>
   static auto
-  marshall(js_env_t *, const js_receiver_t &receiver, js_value_t *&result) {
-    return marshall(receiver, result);
-  }
+  unmarshall(js_env_t *env, js_value_t *value, js_array_t &result) {
+    if constexpr (checked) {
+      int err;
+      err = js_check_value<js_is_array>(env, value, "array");
+      if (err < 0) return err;
+    }
 
-  static auto
-  unmarshall(js_value_t *value, js_receiver_t &result) {
-    result = js_receiver_t(value);
+    result = js_array_t(value);
 
     return 0;
   }
-
-  template <bool checked>
-  static auto
-  unmarshall(js_env_t *, js_value_t *value, js_receiver_t &result) {
-    return unmarshall(value, result);
-  }
 };
 
-template <typename R, typename... A>
-struct js_type_info_t<js_function_t<R, A...>> {
+template <>
+struct js_type_info_t<js_arraybuffer_t> {
   using type = js_value_t *;
 
-  static constexpr auto signature = js_function;
+  static constexpr auto signature = js_object;
 
   template <bool checked>
   static auto
-  unmarshall(js_env_t *env, js_value_t *value, js_function_t<R, A...> &result) {
+  marshall(js_env_t *, const js_arraybuffer_t &arraybuffer, js_value_t *&result) {
+    result = arraybuffer.value;
+
+    return 0;
+  }
+
+  template <bool checked>
+  static auto
+  unmarshall(js_env_t *env, js_value_t *value, js_arraybuffer_t &result) {
     if constexpr (checked) {
       int err;
-      err = js_check_value<js_is_function>(env, value, "function");
+      err = js_check_value<js_is_arraybuffer>(env, value, "arraybuffer");
       if (err < 0) return err;
     }
 
-    result = js_function_t<R, A...>(value);
+    result = js_arraybuffer_t(value);
 
     return 0;
   }
 };
 
 template <>
-struct js_type_info_t<js_external_t> {
+struct js_type_info_t<js_sharedarraybuffer_t> {
   using type = js_value_t *;
 
-  static constexpr auto signature = js_external;
+  static constexpr auto signature = js_object;
 
   template <bool checked>
   static auto
-  marshall(js_env_t *, const js_external_t &external, js_value_t *&result) {
-    result = external.value;
+  marshall(js_env_t *, const js_sharedarraybuffer_t &sharedarraybuffer, js_value_t *&result) {
+    result = sharedarraybuffer.value;
 
     return 0;
   }
 
   template <bool checked>
   static auto
-  unmarshall(js_env_t *env, js_value_t *value, js_external_t &result) {
+  unmarshall(js_env_t *env, js_value_t *value, js_sharedarraybuffer_t &result) {
     if constexpr (checked) {
       int err;
-      err = js_check_value<js_is_external>(env, value, "external");
+      err = js_check_value<js_is_sharedarraybuffer>(env, value, "sharedarraybuffer");
       if (err < 0) return err;
     }
 
-    result = js_external_t(value);
+    result = js_sharedarraybuffer_t(value);
 
     return 0;
   }
 };
 
 template <typename T>
-struct js_type_info_t<T *> {
-  using type = T *;
-
-  static constexpr auto signature = js_external;
-
-  static auto
-  marshall(T *value, T *&result) {
-    result = value;
-
-    return 0;
-  }
+struct js_type_info_t<js_transfer_t<std::span<T>>> {
+  using type = js_value_t *;
 
-  template <bool checked>
-  static auto
-  marshall(js_env_t *, T *value, T *&result) {
-    return marshall(value, result);
-  }
+  static constexpr auto signature = js_object;
 
   template <bool checked>
   static auto
-  marshall(js_env_t *env, T *value, js_value_t *&result) {
-    return js_create_external(env, (void *) value, nullptr, nullptr, &result);
-  }
+  unmarshall(js_env_t *env, js_value_t *value, js_transfer_t<std::span<T>> &result) {
+    int err;
 
-  static auto
-  unmarshall(T *value, T *&result) {
-    result = value;
+    if constexpr (checked) {
+      err = js_check_value<js_is_arraybuffer>(env, value, "arraybuffer");
+      if (err < 0) return err;
+    }
 
-    return 0;
+    return js_detach_arraybuffer(env, js_arraybuffer_t(value), result);
   }
 
   template <bool checked>
   static auto
-  unmarshall(js_env_t *, T *value, T *&result) {
-    return unmarshall(value, result);
-  }
+  prepare(js_env_t *env, js_value_t *value, js_transfer_t<std::span<T>> &result) {
+    int err;
 
-  template <bool checked>
-  static auto
-  unmarshall(js_env_t *env, js_value_t *value, T *&result) {
     if constexpr (checked) {
-      int err;
-      err = js_check_value<js_is_external>(env, value, "external");
+      err = js_check_value<js_is_arraybuffer>(env, value, "arraybuffer");
       if (err < 0) return err;
     }
 
-    return js_get_value_external(env, value, (void **) &result);
+    return js_prepare_transfer(env, js_arraybuffer_t(value), result);
   }
 };
 
-template <size_t N>
-struct js_type_info_t<char[N]> {
+template <typename D, typename S, bool clamp, std::endian endian>
+struct js_type_info_t<js_typedarray_conversion_t<D, S, clamp, endian>> {
   using type = js_value_t *;
 
-  static constexpr auto signature = js_string;
-
-  template <bool checked>
-  static auto
-  marshall(js_env_t *env, const char value[N], js_value_t *&result) {
-    return js_create_string_utf8(env, (const utf8_t *) value, N, &result);
-  }
+  static constexpr auto signature = js_object;
 
   template <bool checked>
   static auto
-  unmarshall(js_env_t *env, js_value_t *value, char result[N]) {
+  unmarshall(js_env_t *env, js_value_t *value, js_typedarray_conversion_t<D, S, clamp, endian> &result) {
     int err;
 
     if constexpr (checked) {
-      err = js_check_value<js_is_string>(env, value, "string");
+      err = js_check_value<js_is_typedarray<S>>(env, value, js_typedarray_info_t<S>::label);
       if (err < 0) return err;
     }
 
+    S *data;
     size_t len;
-    err = js_get_value_string_utf8(env, value, (utf8_t *) result, N, &len);
+    err = js_get_typedarray_info(env, value, nullptr, (void **) &data, &len, nullptr, nullptr);
     if (err < 0) return err;
 
-    assert(len == N);
+    result.value.resize(len);
+
+    js_convert<D, clamp, endian>(data, result.value.data(), len);
 
     return 0;
   }
 };
 
-template <size_t N>
-struct js_type_info_t<const char[N]> {
+template <>
+struct js_type_info_t<js_dataview_t> {
   using type = js_value_t *;
 
-  static constexpr auto signature = js_string;
+  static constexpr auto signature = js_object;
 
   template <bool checked>
   static auto
-  marshall(js_env_t *env, const char value[N], js_value_t *&result) {
-    return js_create_string_utf8(env, (const utf8_t *) value, N, &result);
-  }
-};
-
-template <>
-struct js_type_info_t<char *> {
-  using type = js_value_t *;
+  marshall(js_env_t *, const js_dataview_t &dataview, js_value_t *&result) {
+    result = dataview.value;
 
-  static constexpr auto signature = js_string;
+    return 0;
+  }
 
   template <bool checked>
   static auto
-  marshall(js_env_t *env, const char *value, js_value_t *&result) {
-    return js_create_string_utf8(env, (const utf8_t *) value, -1, &result);
-  }
-};
-
-template <>
-struct js_type_info_t<const char *> {
-  using type = js_value_t *;
+  unmarshall(js_env_t *env, js_value_t *value, js_dataview_t &result) {
+    if constexpr (checked) {
+      int err;
+      err = js_check_value<js_is_dataview>(env, value, "dataview");
+      if (err < 0) return err;
+    }
 
-  static constexpr auto signature = js_string;
+    result = js_dataview_t(value);
 
-  template <bool checked>
-  static auto
-  marshall(js_env_t *env, const char *value, js_value_t *&result) {
-    return js_create_string_utf8(env, (const utf8_t *) value, -1, &result);
+    return 0;
   }
 };
 
-template <>
-struct js_type_info_t<std::string> {
+template <typename T>
+struct js_type_info_t<js_typedarray_t<T>> {
   using type = js_value_t *;
 
-  static constexpr auto signature = js_string;
+  static constexpr auto signature = js_object;
 
   template <bool checked>
   static auto
-  marshall(js_env_t *env, const std::string &value, js_value_t *&result) {
-    return js_create_string_utf8(env, (const utf8_t *) value.data(), value.length(), &result);
+  marshall(js_env_t *, const js_typedarray_t<T> &typedarray, js_value_t *&result) {
+    result = typedarray.value;
+
+    return 0;
   }
 
   template <bool checked>
   static auto
-  unmarshall(js_env_t *env, js_value_t *value, std::string &result) {
-    int err;
-
+  unmarshall(js_env_t *env, js_value_t *value, js_typedarray_t<T> &result) {
     if constexpr (checked) {
-      err = js_check_value<js_is_string>(env, value, "string");
+      int err;
+      err = js_check_value<js_is_typedarray<T>>(env, value, js_typedarray_info_t<T>::label);
       if (err < 0) return err;
     }
 
-    size_t len;
-    err = js_get_value_string_utf8(env, value, nullptr, 0, &len);
-    if (err < 0) return err;
-
-    result.resize(len);
+    result = js_typedarray_t<T>(value);
 
-    return js_get_value_string_utf8(env, value, (utf8_t *) result.data(), result.length(), nullptr);
+    return 0;
   }
 };
 
-template <typename T, size_t N>
-struct js_type_info_t<T[N]> {
+template <>
+struct js_type_info_t<js_typedarray_any_t> {
   using type = js_value_t *;
 
   static constexpr auto signature = js_object;
 
   template <bool checked>
   static auto
-  marshall(js_env_t *env, const T array[N], js_value_t *&result) {
-    int err;
-
-    err = js_create_array_with_length(env, N, &result);
-    assert(err == 0);
-
-    js_value_t *values[N];
-
-    for (uint32_t i = 0; i < N; i++) {
-      err = js_type_info_t<T>::template marshall<checked>(env, array[i], values[i]);
-      if (err < 0) return err;
-    }
+  marshall(js_env_t *, const js_typedarray_any_t &typedarray, js_value_t *&result) {
+    result = typedarray.value;
 
-    return js_set_array_elements(env, result, (const js_value_t **) values, N, 0);
+    return 0;
   }
 
   template <bool checked>
   static auto
-  unmarshall(js_env_t *env, js_value_t *value, T result[N]) {
-    int err;
-
+  unmarshall(js_env_t *env, js_value_t *value, js_typedarray_any_t &result) {
     if constexpr (checked) {
-      err = js_check_value<js_is_array>(env, value, "array");
+      int err;
+      err = js_check_value<js_is_typedarray>(env, value, "typedarray");
       if (err < 0) return err;
     }
 
-    js_value_t *values[N];
-    uint32_t len;
-    err = js_get_array_elements(env, value, values, N, 0, &len);
-    if (err < 0) return err;
-
-    assert(len == N);
-
-    for (uint32_t i = 0; i < N; i++) {
-      err = js_type_info_t<T>::template unmarshall<checked>(env, values[i], result[i]);
-      if (err < 0) return err;
-    }
+    result = js_typedarray_any_t(value);
 
     return 0;
   }
 };
 
-template <typename T, size_t N>
-struct js_type_info_t<std::array<T, N>> {
+template <>
+struct js_type_info_t<js_arraybuffer_view_t> {
   using type = js_value_t *;
 
   static constexpr auto signature = js_object;
 
   template <bool checked>
   static auto
-  marshall(js_env_t *env, const std::array<T, N> &array, js_value_t *&result) {
-    int err;
-
-    err = js_create_array_with_length(env, N, &result);
-    assert(err == 0);
-
-    js_value_t *values[N];
-
-    for (uint32_t i = 0; i < N; i++) {
-      err = js_type_info_t<T>::template marshall<checked>(env, array[i], values[i]);
-      if (err < 0) return err;
-    }
+  marshall(js_env_t *, const js_arraybuffer_view_t &view, js_value_t *&result) {
+    result = view.value;
 
-    return js_set_array_elements(env, result, (const js_value_t **) values, N, 0);
+    return 0;
   }
 
   template <bool checked>
   static auto
-  unmarshall(js_env_t *env, js_value_t *value, std::array<T, N> &result) {
-    int err;
-
+  unmarshall(js_env_t *env, js_value_t *value, js_arraybuffer_view_t &result) {
     if constexpr (checked) {
-      err = js_check_value<js_is_array>(env, value, "array");
+      int err;
+      err = js_check_value<js_is_arraybuffer_view>(env, value, "arraybufferview");
       if (err < 0) return err;
     }
 
-    js_value_t *values[N];
-    uint32_t len;
-    err = js_get_array_elements(env, value, values, N, 0, &len);
-    if (err < 0) return err;
-
-    assert(len == N);
-
-    for (uint32_t i = 0; i < N; i++) {
-      err = js_type_info_t<T>::template unmarshall<checked>(env, values[i], result[i]);
-      if (err < 0) return err;
-    }
+    result = js_arraybuffer_view_t(value);
 
     return 0;
   }
 };
 
-template <typename T>
-struct js_type_info_t<std::vector<T>> {
+template <>
+struct js_type_info_t<js_receiver_t> {
   using type = js_value_t *;
 
   static constexpr auto signature = js_object;
 
-  template <bool checked>
   static auto
-  marshall(js_env_t *env, const std::vector<T> &vector, js_value_t *&result) {
-    int err;
-
-    auto len = vector.size();
+  marshall(const js_receiver_t &receiver, js_value_t *&result) {
+    result = receiver.value;
 
-    err = js_create_array_with_length(env, len, &result);
-    assert(err == 0);
+    return 0;
+  }
 
-    std::vector<js_value_t *> values(len);
+  template <bool checked>
+  static auto
+  marshall(js_env_t *, const js_receiver_t &receiver, js_value_t *&result) {
+    return marshall(receiver, result);
+  }
 
-    for (uint32_t i = 0; i < len; i++) {
-      err = js_type_info_t<T>::template marshall<checked>(env, vector[i], values[i]);
-      if (err < 0) return err;
-    }
+  static auto
+  unmarshall(js_value_t *value, js_receiver_t &result) {
+    result = js_receiver_t(value);
 
-    return js_set_array_elements(env, result, (const js_value_t **) values.data(), len, 0);
+    return 0;
   }
 
   template <bool checked>
   static auto
-  unmarshall(js_env_t *env, js_value_t *value, std::vector<T> &result) {
-    int err;
+  unmarshall(js_env_t *, js_value_t *value, js_receiver_t &result) {
+    return unmarshall(value, result);
+  }
+};
+
+template <typename R, typename... A>
+struct js_type_info_t<js_function_t<R, A...>> {
+  using type = js_value_t *;
 
+  static constexpr auto signature = js_function;
+
+  template <bool checked>
+  static auto
+  unmarshall(js_env_t *env, js_value_t *value, js_function_t<R, A...> &result) {
     if constexpr (checked) {
-      err = js_check_value<js_is_array>(env, value, "array");
+      int err;
+      err = js_check_value<js_is_function>(env, value, "function");
       if (err < 0) return err;
     }
 
-    uint32_t len;
-    err = js_get_array_length(env, value, &len);
-    if (err < 0) return err;
+    result = js_function_t<R, A...>(value);
 
-    std::vector<js_value_t *> values(len);
-    err = js_get_array_elements(env, value, values.data(), len, 0, &len);
-    if (err < 0) return err;
+    return 0;
+  }
+};
 
-    result.resize(len);
+template <>
+struct js_type_info_t<js_external_t> {
+  using type = js_value_t *;
 
-    for (uint32_t i = 0; i < len; i++) {
-      err = js_type_info_t<T>::template unmarshall<checked>(env, values[i], result[i]);
+  static constexpr auto signature = js_external;
+
+  template <bool checked>
+  static auto
+  marshall(js_env_t *, const js_external_t &external, js_value_t *&result) {
+    result = external.value;
+
+    return 0;
+  }
+
+  template <bool checked>
+  static auto
+  unmarshall(js_env_t *env, js_value_t *value, js_external_t &result) {
+    if constexpr (checked) {
+      int err;
+      err = js_check_value<js_is_external>(env, value, "external");
       if (err < 0) return err;
     }
 
+    result = js_external_t(value);
+
     return 0;
   }
 };
 
 template <typename T>
-struct js_property_t {
-  std::string name;
-  T value;
+struct js_type_info_t<js_class_t<T>> {
+  using type = js_value_t *;
+
+  static constexpr auto signature = js_function;
 
-  js_property_t(const std::string &name, T value) : name(name), value(value) {}
+  template <bool checked>
+  static auto
+  marshall(js_env_t *, const js_class_t<T> &constructor, js_value_t *&result) {
+    result = constructor.value;
+
+    return 0;
+  }
+
+  template <bool checked>
+  static auto
+  unmarshall(js_env_t *env, js_value_t *value, js_class_t<T> &result) {
+    if constexpr (checked) {
+      int err;
+      err = js_check_value<js_is_function>(env, value, "function");
+      if (err < 0) return err;
+    }
 
-  template <size_t N>
-  js_property_t(const char name[N], T value) : name(name, N), value(value) {}
+    result = js_class_t<T>(value);
 
-  js_property_t(const char *name, T value) : name(name), value(value) {}
+    return 0;
+  }
 };
 
 template <typename T>
-static inline auto
-js_marshall_typed_value(T value) {
-  int err;
+struct js_type_info_t<T *> {
+  using type = T *;
 
-  typename js_type_info_t<T>::type result;
-  err = js_type_info_t<T>::marshall(value, result);
-  if (err < 0) throw err;
+  static constexpr auto signature = js_external;
 
-  return result;
-}
+  static auto
+  marshall(T *value, T *&result) {
+    result = value;
 
-template <bool checked = js_is_debug, typename T>
-static inline auto
-js_marshall_typed_value(js_env_t *env, T value) {
-  int err;
+    return 0;
+  }
 
-  typename js_type_info_t<T>::type result;
-  err = js_type_info_t<T>::template marshall<checked>(env, value, result);
-  if (err < 0) throw err;
+  template <bool checked>
+  static auto
+  marshall(js_env_t *, T *value, T *&result) {
+    return marshall(value, result);
+  }
 
-  return result;
-}
+  template <bool checked>
+  static auto
+  marshall(js_env_t *env, T *value, js_value_t *&result) {
+    return js_create_external(env, (void *) value, nullptr, nullptr, &result);
+  }
 
-template <bool checked = js_is_debug, typename T>
-static inline auto
-js_marshall_untyped_value(js_env_t *env, T value) {
-  int err;
+  static auto
+  unmarshall(T *value, T *&result) {
+    result = value;
 
-  js_value_t *result;
-  err = js_type_info_t<T>::template marshall<checked>(env, value, result);
-  if (err < 0) throw err;
+    return 0;
+  }
 
-  return result;
-}
+  template <bool checked>
+  static auto
+  unmarshall(js_env_t *, T *value, T *&result) {
+    return unmarshall(value, result);
+  }
 
-template <bool checked = js_is_debug>
-static inline auto
-js_marshall_untyped_value(js_env_t *env) {
-  int err;
+  template <bool checked>
+  static auto
+  unmarshall(js_env_t *env, js_value_t *value, T *&result) {
+    if constexpr (checked) {
+      int err;
+      err = js_check_value<js_is_external>(env, value, "external");
+      if (err < 0) return err;
+    }
 
-  js_value_t *result;
-  err = js_type_info_t<void>::template marshall<checked>(env, result);
-  if (err < 0) throw err;
+    return js_get_value_external(env, value, (void **) &result);
+  }
+};
 
-  return result;
-}
+template <typename T>
+struct js_external_info_t {
+  static auto
+  size(const T &) {
+    return sizeof(T);
+  }
+};
 
 template <typename T>
-static inline auto
-js_unmarshall_typed_value(typename js_type_info_t<T>::type value) {
-  int err;
+struct js_type_info_t<std::unique_ptr<T>> {
+  using type = js_value_t *;
 
-  T result;
-  err = js_type_info_t<T>::unmarshall(value, result);
-  if (err < 0) throw err;
+  static constexpr auto signature = js_external;
 
-  return result;
-}
+  static void
+  finalize(js_env_t *, void *data, void *hint) {
+    delete static_cast<T *>(data);
+    delete static_cast<js_external_memory_t *>(hint);
+  }
 
-template <bool checked = js_is_debug, typename T>
-static inline auto
-js_unmarshall_typed_value(js_env_t *env, typename js_type_info_t<T>::type value) {
-  int err;
+  template <bool checked>
+  static auto
+  marshall(js_env_t *env, std::unique_ptr<T> &value, js_value_t *&result) {
+    int err;
 
-  T result;
-  err = js_type_info_t<T>::template unmarshall<checked>(env, value, result);
-  if (err < 0) throw err;
+    if (value == nullptr) return js_get_null(env, &result);
 
-  return result;
-}
+    auto memory = new js_external_memory_t(env, js_external_info_t<T>::size(*value));
 
-template <bool checked = js_is_debug, typename T>
-static inline auto
-js_unmarshall_untyped_value(js_env_t *env, js_value_t *value) {
-  int err;
+    err = js_create_external(env, (void *) value.get(), finalize, (void *) memory, &result);
 
-  T result;
-  err = js_type_info_t<T>::template unmarshall<checked>(env, value, result);
-  if (err < 0) throw err;
+    if (err < 0) {
+      delete memory;
 
-  return result;
-}
+      return err;
+    }
 
-template <typename...>
-struct js_argument_info_t;
+    value.release();
 
-template <>
-struct js_argument_info_t<> {
-  static constexpr bool has_receiver = false;
+    return 0;
+  }
 };
 
-template <typename T, typename... R>
-struct js_argument_info_t<T, R...> {
-  static constexpr bool has_receiver = std::is_same<T, js_receiver_t>();
-};
+template <typename T>
+struct js_type_info_t<std::shared_ptr<T>> {
+  using type = js_value_t *;
 
-template <auto fn>
-struct js_typed_callback_t;
+  static constexpr auto signature = js_external;
 
-template <typename R, typename... A, R fn(A...)>
-struct js_typed_callback_t<fn> {
-  template <bool checked, bool scoped>
-  static inline auto
-  create() {
-    return +[](typename js_type_info_t<A>::type... args, js_typed_callback_info_t *info) -> typename js_type_info_t<R>::type {
-      return js_marshall_typed_value<R>(fn(js_unmarshall_typed_value<A>(args)...));
-    };
+  static inline const char anchor = 0;
+
+  static inline const js_type_tag_t tag = {uint64_t(uintptr_t(&anchor)), 0x7368617265645f70};
+
+  static void
+  finalize(js_env_t *, void *data, void *hint) {
+    delete static_cast<std::shared_ptr<T> *>(data);
+    delete static_cast<js_external_memory_t *>(hint);
   }
-};
 
-template <typename R, typename... A, R fn(js_env_t *, A...)>
-struct js_typed_callback_t<fn> {
-  template <bool checked, bool scoped>
-  static inline auto
-  create() {
-    return +[](typename js_type_info_t<A>::type... args, js_typed_callback_info_t *info) -> typename js_type_info_t<R>::type {
-      int err;
+  template <bool checked>
+  static auto
+  marshall(js_env_t *env, const std::shared_ptr<T> &value, js_value_t *&result) {
+    int err;
 
-      js_env_t *env;
-      err = js_get_typed_callback_info(info, &env, nullptr);
-      assert(err == 0);
+    if (value == nullptr) return js_get_null(env, &result);
 
-      js_escapable_handle_scope_t *scope;
+    auto data = new std::shared_ptr<T>(value);
 
-      if constexpr (scoped) {
-        err = js_open_escapable_handle_scope(env, &scope);
-        assert(err == 0);
-      }
+    auto memory = new js_external_memory_t(env, js_external_info_t<T>::size(*value));
 
-      typename js_type_info_t<R>::type result;
+    err = js_create_external(env, (void *) data, finalize, (void *) memory, &result);
 
-      try {
-        result = js_marshall_typed_value<checked, R>(env, fn(env, js_unmarshall_typed_value<checked, A>(env, args)...));
+    if (err < 0) {
+      delete data;
+      delete memory;
 
-        if constexpr (scoped && std::is_same<decltype(result), js_value_t *>()) {
-          err = js_escape_handle(env, scope, result, &result);
-          assert(err == 0);
-        }
-      } catch (int err) {
-        assert(err != 0);
-      }
+      return err;
+    }
 
-      if constexpr (scoped) {
-        err = js_close_escapable_handle_scope(env, scope);
-        assert(err == 0);
-      }
+    return js_add_type_tag(env, result, &tag);
+  }
 
-      return result;
-    };
+  template <bool checked>
+  static int
+  unmarshall(js_env_t *env, js_value_t *value, std::shared_ptr<T> &result) {
+    int err;
+
+    if constexpr (checked) {
+      err = js_check_value<js_is_external>(env, value, "external");
+      if (err < 0) return err;
+    }
+
+    bool is_shared;
+    err = js_check_type_tag(env, value, &tag, &is_shared);
+    if (err < 0) return err;
+
+    if (!is_shared) {
+      err = js_throw_type_error(env, nullptr, "Value is not of type 'shared_ptr'");
+      assert(err == 0);
+
+      return js_pending_exception;
+    }
+
+    std::shared_ptr<T> *data;
+    err = js_get_value_external(env, value, (void **) &data);
+    if (err < 0) return err;
+
+    result = *data;
+
+    return 0;
   }
 };
 
-template <typename... A, void fn(A...)>
-struct js_typed_callback_t<fn> {
-  template <bool checked, bool scoped>
-  static inline auto
-  create() {
-    return +[](typename js_type_info_t<A>::type... args, js_typed_callback_info_t *info) -> void {
-      fn(js_unmarshall_typed_value<A>(args)...);
-    };
+template <size_t N>
+struct js_type_info_t<char[N]> {
+  using type = js_value_t *;
+
+  static constexpr auto signature = js_string;
+
+  template <bool checked>
+  static auto
+  marshall(js_env_t *env, const char value[N], js_value_t *&result) {
+    return js_create_string_ascii_or_utf8(env, value, N, &result);
+  }
+
+  template <bool checked>
+  static auto
+  unmarshall(js_env_t *env, js_value_t *value, char result[N]) {
+    int err;
+
+    if constexpr (checked) {
+      err = js_check_value<js_is_string>(env, value, "string");
+      if (err < 0) return err;
+    }
+
+    size_t len;
+    err = js_get_value_string_utf8(env, value, (utf8_t *) result, N, &len);
+    if (err < 0) return err;
+
+    assert(len == N);
+
+    return 0;
   }
 };
 
-template <typename... A, void fn(js_env_t *, A...)>
-struct js_typed_callback_t<fn> {
-  template <bool checked, bool scoped>
-  static inline auto
-  create() {
-    return +[](typename js_type_info_t<A>::type... args, js_typed_callback_info_t *info) -> void {
-      int err;
+template <size_t N>
+struct js_type_info_t<const char[N]> {
+  using type = js_value_t *;
 
-      js_env_t *env;
-      err = js_get_typed_callback_info(info, &env, nullptr);
-      assert(err == 0);
+  static constexpr auto signature = js_string;
 
-      js_handle_scope_t *scope;
+  template <bool checked>
+  static auto
+  marshall(js_env_t *env, const char value[N], js_value_t *&result) {
+    return js_create_string_ascii_or_utf8(env, value, N, &result);
+  }
+};
 
-      if constexpr (scoped) {
-        err = js_open_handle_scope(env, &scope);
-        assert(err == 0);
-      }
+template <>
+struct js_type_info_t<char *> {
+  using type = js_value_t *;
 
-      try {
-        fn(env, js_unmarshall_typed_value<checked, A>(env, args)...);
-      } catch (int err) {
-        assert(err != 0);
-      }
+  static constexpr auto signature = js_string;
 
-      if constexpr (scoped) {
-        err = js_close_handle_scope(env, scope);
-        assert(err == 0);
-      }
-    };
+  template <bool checked>
+  static auto
+  marshall(js_env_t *env, const char *value, js_value_t *&result) {
+    return js_create_string_ascii_or_utf8(env, value, strlen(value), &result);
   }
 };
 
-template <auto fn>
-struct js_untyped_callback_t;
+template <>
+struct js_type_info_t<const char *> {
+  using type = js_value_t *;
 
-template <typename R, typename... A, R fn(A...)>
-struct js_untyped_callback_t<fn> {
-  template <bool checked, bool scoped, size_t... I>
-  static inline auto
-  create(std::index_sequence<I...>) {
-    return +[](js_env_t *env, js_callback_info_t *info) -> js_value_t * {
-      int err;
+  static constexpr auto signature = js_string;
+
+  template <bool checked>
+  static auto
+  marshall(js_env_t *env, const char *value, js_value_t *&result) {
+    return js_create_string_ascii_or_utf8(env, value, strlen(value), &result);
+  }
+};
+
+template <>
+struct js_type_info_t<std::string> {
+  using type = js_value_t *;
+
+  static constexpr auto signature = js_string;
+
+  template <bool checked>
+  static auto
+  marshall(js_env_t *env, const std::string &value, js_value_t *&result) {
+    return js_create_string_ascii_or_utf8(env, value.data(), value.length(), &result);
+  }
+
+  template <bool checked>
+  static auto
+  unmarshall(js_env_t *env, js_value_t *value, std::string &result) {
+    int err;
+
+    if constexpr (checked) {
+      err = js_check_value<js_is_string>(env, value, "string");
+      if (err < 0) return err;
+    }
+
+    size_t len;
+    err = js_get_value_string_utf8(env, value, nullptr, 0, &len);
+    if (err < 0) return err;
+
+    result.resize(len);
+
+    return js_get_value_string_utf8(env, value, (utf8_t *) result.data(), result.length(), nullptr);
+  }
+};
+
+template <typename T, size_t N>
+struct js_type_info_t<T[N]> {
+  using type = js_value_t *;
+
+  static constexpr auto signature = js_object;
+
+  template <bool checked>
+  static auto
+  marshall(js_env_t *env, const T array[N], js_value_t *&result) {
+    int err;
+
+    err = js_create_array_with_length(env, N, &result);
+    assert(err == 0);
+
+    js_value_t *values[N];
+
+    for (uint32_t i = 0; i < N; i++) {
+      err = js_type_info_t<T>::template marshall<checked>(env, array[i], values[i]);
+      if (err < 0) return err;
+    }
+
+    return js_set_array_elements(env, result, (const js_value_t **) values, N, 0);
+  }
+
+  template <bool checked>
+  static auto
+  unmarshall(js_env_t *env, js_value_t *value, T result[N]) {
+    int err;
+
+    if constexpr (checked) {
+      err = js_check_value<js_is_array>(env, value, "array");
+      if (err < 0) return err;
+    }
+
+    js_value_t *values[N];
+    uint32_t len;
+    err = js_get_array_elements(env, value, values, N, 0, &len);
+    if (err < 0) return err;
+
+    assert(len == N);
+
+    for (uint32_t i = 0; i < N; i++) {
+      err = js_type_info_t<T>::template unmarshall<checked>(env, values[i], result[i]);
+      if (err < 0) return err;
+    }
+
+    return 0;
+  }
+};
+
+template <typename T, size_t N>
+struct js_type_info_t<std::array<T, N>> {
+  using type = js_value_t *;
+
+  static constexpr auto signature = js_object;
+
+  template <bool checked>
+  static auto
+  marshall(js_env_t *env, const std::array<T, N> &array, js_value_t *&result) {
+    int err;
+
+    err = js_create_array_with_length(env, N, &result);
+    assert(err == 0);
+
+    js_value_t *values[N];
+
+    for (uint32_t i = 0; i < N; i++) {
+      err = js_type_info_t<T>::template marshall<checked>(env, array[i], values[i]);
+      if (err < 0) return err;
+    }
+
+    return js_set_array_elements(env, result, (const js_value_t **) values, N, 0);
+  }
+
+  template <bool checked>
+  static auto
+  unmarshall(js_env_t *env, js_value_t *value, std::array<T, N> &result) {
+    int err;
+
+    if constexpr (checked) {
+      err = js_check_value<js_is_array>(env, value, "array");
+      if (err < 0) return err;
+    }
+
+    js_value_t *values[N];
+    uint32_t len;
+    err = js_get_array_elements(env, value, values, N, 0, &len);
+    if (err < 0) return err;
+
+    assert(len == N);
+
+    for (uint32_t i = 0; i < N; i++) {
+      err = js_type_info_t<T>::template unmarshall<checked>(env, values[i], result[i]);
+      if (err < 0) return err;
+    }
+
+    return 0;
+  }
+};
+
+template <typename T>
+struct js_type_info_t<std::vector<T>> {
+  using type = js_value_t *;
+
+  static constexpr auto signature = js_object;
+
+  template <bool checked>
+  static auto
+  marshall(js_env_t *env, const std::vector<T> &vector, js_value_t *&result) {
+    int err;
+
+    auto len = vector.size();
+
+    err = js_create_array_with_length(env, len, &result);
+    assert(err == 0);
+
+    std::vector<js_value_t *> values(len);
+
+    for (uint32_t i = 0; i < len; i++) {
+      err = js_type_info_t<T>::template marshall<checked>(env, vector[i], values[i]);
+      if (err < 0) return err;
+    }
+
+    return js_set_array_elements(env, result, (const js_value_t **) values.data(), len, 0);
+  }
+
+  template <bool checked>
+  static auto
+  unmarshall(js_env_t *env, js_value_t *value, std::vector<T> &result) {
+    int err;
+
+    if constexpr (checked) {
+      err = js_check_value<js_is_array>(env, value, "array");
+      if (err < 0) return err;
+    }
+
+    uint32_t len;
+    err = js_get_array_length(env, value, &len);
+    if (err < 0) return err;
+
+    std::vector<js_value_t *> values(len);
+    err = js_get_array_elements(env, value, values.data(), len, 0, &len);
+    if (err < 0) return err;
+
+    result.resize(len);
+
+    for (uint32_t i = 0; i < len; i++) {
+      err = js_type_info_t<T>::template unmarshall<checked>(env, values[i], result[i]);
+      if (err < 0) return err;
+    }
+
+    return 0;
+  }
+};
+
+template <size_t N>
+struct js_string_literal_t {
+  char value[N];
+
+  constexpr js_string_literal_t(const char (&value)[N]) {
+    for (size_t i = 0; i < N; i++) this->value[i] = value[i];
+  }
+
+  static constexpr size_t length = N - 1;
+};
+
+template <size_t N>
+struct js_type_info_t<js_string_literal_t<N>> {
+  using type = js_value_t *;
+
+  static constexpr auto signature = js_string;
+
+  template <bool checked>
+  static auto
+  marshall(js_env_t *env, const js_string_literal_t<N> &value, js_value_t *&result) {
+    return js_create_string_ascii_or_utf8(env, value.value, value.length, &result);
+  }
+};
+
+template <typename T>
+struct js_tuple_type_info_t {
+  using type = js_value_t *;
+
+  static constexpr auto signature = js_object;
+
+  static constexpr auto size = std::tuple_size<T>();
+
+  template <bool checked, size_t... I>
+  static auto
+  marshall(js_env_t *env, const T &tuple, js_value_t *&result, std::index_sequence<I...>) {
+    int err;
+
+    js_value_t *values[size];
+
+    if (!(((err = js_type_info_t<std::tuple_element_t<I, T>>::template marshall<checked>(env, std::get<I>(tuple), values[I])) == 0) && ...)) return err;
+
+    err = js_create_array_with_length(env, size, &result);
+    if (err < 0) return err;
+
+    return js_set_array_elements(env, result, (const js_value_t **) values, size, 0);
+  }
+
+  template <bool checked>
+  static auto
+  marshall(js_env_t *env, const T &tuple, js_value_t *&result) {
+    return marshall<checked>(env, tuple, result, std::make_index_sequence<size>());
+  }
+
+  template <bool checked, size_t... I>
+  static auto
+  unmarshall(js_env_t *env, js_value_t *value, T &result, std::index_sequence<I...>) {
+    int err;
+
+    if constexpr (checked) {
+      err = js_check_value<js_is_array>(env, value, "array");
+      if (err < 0) return err;
+    }
+
+    js_value_t *values[size];
+    uint32_t len;
+    err = js_get_array_elements(env, value, values, size, 0, &len);
+    if (err < 0) return err;
+
+    assert(len == size);
+
+    if (!(((err = js_type_info_t<std::tuple_element_t<I, T>>::template unmarshall<checked>(env, values[I], std::get<I>(result))) == 0) && ...)) return err;
+
+    return 0;
+  }
+
+  template <bool checked>
+  static auto
+  unmarshall(js_env_t *env, js_value_t *value, T &result) {
+    return unmarshall<checked>(env, value, result, std::make_index_sequence<size>());
+  }
+};
+
+template <typename... T>
+struct js_type_info_t<std::tuple<T...>> : js_tuple_type_info_t<std::tuple<T...>> {};
+
+template <typename A, typename B>
+struct js_type_info_t<std::pair<A, B>> : js_tuple_type_info_t<std::pair<A, B>> {};
+
+template <typename M>
+struct js_map_type_info_t {
+  using key_type = typename M::key_type;
+  using mapped_type = typename M::mapped_type;
+
+  using type = js_value_t *;
+
+  static constexpr auto signature = js_object;
+
+  static constexpr bool is_object = std::is_same<key_type, std::string>();
+
+  template <bool checked>
+  static auto
+  marshall(js_env_t *env, const M &map, js_value_t *&result) {
+    int err;
+
+    if constexpr (is_object) {
+      err = js_create_object(env, &result);
+      if (err < 0) return err;
+
+      std::vector<js_property_descriptor_t> descriptors(map.size());
+
+      size_t i = 0;
+
+      for (const auto &[key, value] : map) {
+        auto &descriptor = descriptors[i++];
+
+        descriptor.version = 0;
+        descriptor.data = nullptr;
+        descriptor.attributes = js_writable | js_enumerable | js_configurable;
+        descriptor.method = nullptr;
+        descriptor.getter = nullptr;
+        descriptor.setter = nullptr;
+
+        err = js_create_string_utf8(env, (const utf8_t *) key.data(), key.length(), &descriptor.name);
+        if (err < 0) return err;
+
+        err = js_type_info_t<mapped_type>::template marshall<checked>(env, value, descriptor.value);
+        if (err < 0) return err;
+      }
+
+      return js_define_properties(env, result, descriptors.data(), descriptors.size());
+    } else {
+      auto len = map.size();
+
+      std::vector<js_value_t *> entries(len);
+
+      size_t i = 0;
+
+      for (const auto &[key, value] : map) {
+        js_value_t *pair[2];
+
+        err = js_type_info_t<key_type>::template marshall<checked>(env, key, pair[0]);
+        if (err < 0) return err;
+
+        err = js_type_info_t<mapped_type>::template marshall<checked>(env, value, pair[1]);
+        if (err < 0) return err;
+
+        auto &entry = entries[i++];
+
+        err = js_create_array_with_length(env, 2, &entry);
+        if (err < 0) return err;
+
+        err = js_set_array_elements(env, entry, (const js_value_t **) pair, 2, 0);
+        if (err < 0) return err;
+      }
+
+      js_value_t *array;
+      err = js_create_array_with_length(env, len, &array);
+      if (err < 0) return err;
+
+      err = js_set_array_elements(env, array, (const js_value_t **) entries.data(), len, 0);
+      if (err < 0) return err;
+
+      js_value_t *global;
+      err = js_get_global(env, &global);
+      if (err < 0) return err;
+
+      js_value_t *constructor;
+      err = js_get_named_property(env, global, "Map", &constructor);
+      if (err < 0) return err;
+
+      return js_new_instance(env, constructor, 1, &array, &result);
+    }
+  }
+
+  template <bool checked>
+  static int
+  unmarshall(js_env_t *env, js_value_t *value, M &result) {
+    int err;
+
+    if constexpr (checked) {
+      if constexpr (is_object) {
+        err = js_check_value<js_is_object>(env, value, "object");
+        if (err < 0) return err;
+      } else {
+        err = js_check_value<js_is_map>(env, value, "map");
+        if (err < 0) return err;
+      }
+    }
+
+    result.clear();
+
+    js_value_t *global;
+    err = js_get_global(env, &global);
+    if (err < 0) return err;
+
+    js_value_t *constructor;
+    err = js_get_named_property(env, global, is_object ? "Object" : "Array", &constructor);
+    if (err < 0) return err;
+
+    js_value_t *function;
+    err = js_get_named_property(env, constructor, is_object ? "entries" : "from", &function);
+    if (err < 0) return err;
+
+    js_value_t *array;
+    err = js_call_function(env, constructor, function, 1, &value, &array);
+    if (err < 0) return err;
+
+    uint32_t len;
+    err = js_get_array_length(env, array, &len);
+    if (err < 0) return err;
+
+    std::vector<js_value_t *> entries(len);
+    err = js_get_array_elements(env, array, entries.data(), len, 0, &len);
+    if (err < 0) return err;
+
+    for (uint32_t i = 0; i < len; i++) {
+      js_value_t *pair[2];
+      uint32_t n;
+      err = js_get_array_elements(env, entries[i], pair, 2, 0, &n);
+      if (err < 0) return err;
+
+      if (n != 2) {
+        err = js_throw_type_error(env, nullptr, "Map entry is not a key-value pair");
+        assert(err == 0);
+
+        return js_pending_exception;
+      }
+
+      key_type key;
+      err = js_type_info_t<key_type>::template unmarshall<checked>(env, pair[0], key);
+      if (err < 0) return err;
+
+      mapped_type mapped;
+      err = js_type_info_t<mapped_type>::template unmarshall<checked>(env, pair[1], mapped);
+      if (err < 0) return err;
+
+      result.emplace(std::move(key), std::move(mapped));
+    }
+
+    return 0;
+  }
+};
+
+template <typename K, typename V>
+struct js_type_info_t<std::map<K, V>> : js_map_type_info_t<std::map<K, V>> {};
+
+template <typename K, typename V>
+struct js_type_info_t<std::unordered_map<K, V>> : js_map_type_info_t<std::unordered_map<K, V>> {};
+
+static constexpr auto
+js_typeof_signature(js_value_type_t signature) {
+  switch (signature) {
+  case js_int32:
+  case js_uint32:
+  case js_int64:
+  case js_float64:
+    return js_number;
+  case js_null:
+    return js_undefined;
+  default:
+    return signature;
+  }
+}
+
+template <typename T>
+struct js_argument_check_t {
+  static constexpr bool labeled = false;
+};
+
+template <int check(js_env_t *, js_value_t *, bool *)>
+struct js_typed_argument_check_t {
+  static constexpr bool labeled = true;
+
+  static inline auto
+  is(js_env_t *env, js_value_t *value, bool &result) {
+    return check(env, value, &result);
+  }
+};
+
+template <>
+struct js_argument_check_t<bool> : js_typed_argument_check_t<js_is_boolean> {
+  static constexpr auto label = "boolean";
+};
+
+template <>
+struct js_argument_check_t<int32_t> : js_typed_argument_check_t<js_is_int32> {
+  static constexpr auto label = "int32";
+};
+
+template <>
+struct js_argument_check_t<uint32_t> : js_typed_argument_check_t<js_is_uint32> {
+  static constexpr auto label = "uint32";
+};
+
+template <>
+struct js_argument_check_t<int64_t> : js_typed_argument_check_t<js_is_number> {
+  static constexpr auto label = "int64";
+};
+
+template <>
+struct js_argument_check_t<double> : js_typed_argument_check_t<js_is_number> {
+  static constexpr auto label = "double";
+};
+
+template <>
+struct js_argument_check_t<js_bigint_t> : js_typed_argument_check_t<js_is_bigint> {
+  static constexpr auto label = "bigint";
+};
+
+template <>
+struct js_argument_check_t<js_string_t> : js_typed_argument_check_t<js_is_string> {
+  static constexpr auto label = "string";
+};
+
+template <>
+struct js_argument_check_t<js_symbol_t> : js_typed_argument_check_t<js_is_symbol> {
+  static constexpr auto label = "symbol";
+};
+
+template <>
+struct js_argument_check_t<js_object_t> : js_typed_argument_check_t<js_is_object> {
+  static constexpr auto label = "object";
+};
+
+template <>
+struct js_argument_check_t<js_array_t> : js_typed_argument_check_t<js_is_array> {
+  static constexpr auto label = "array";
+};
+
+template <>
+struct js_argument_check_t<js_arraybuffer_t> : js_typed_argument_check_t<js_is_arraybuffer> {
+  static constexpr auto label = "arraybuffer";
+};
+
+template <>
+struct js_argument_check_t<js_sharedarraybuffer_t> : js_typed_argument_check_t<js_is_sharedarraybuffer> {
+  static constexpr auto label = "sharedarraybuffer";
+};
+
+template <>
+struct js_argument_check_t<js_dataview_t> : js_typed_argument_check_t<js_is_dataview> {
+  static constexpr auto label = "dataview";
+};
+
+template <>
+struct js_argument_check_t<js_typedarray_any_t> : js_typed_argument_check_t<js_is_typedarray> {
+  static constexpr auto label = "typedarray";
+};
+
+template <>
+struct js_argument_check_t<js_arraybuffer_view_t> {
+  static constexpr bool labeled = true;
+
+  static constexpr auto label = "arraybufferview";
+
+  static inline auto
+  is(js_env_t *env, js_value_t *value, bool &result) {
+    return js_is_arraybuffer_view(env, value, &result);
+  }
+};
+
+template <>
+struct js_argument_check_t<js_external_t> : js_typed_argument_check_t<js_is_external> {
+  static constexpr auto label = "external";
+};
+
+template <>
+struct js_argument_check_t<std::string> : js_typed_argument_check_t<js_is_string> {
+  static constexpr auto label = "string";
+};
+
+template <typename T>
+struct js_argument_check_t<js_transfer_t<std::span<T>>> : js_typed_argument_check_t<js_is_arraybuffer> {
+  static constexpr auto label = "arraybuffer";
+};
+
+template <typename T>
+struct js_argument_check_t<js_typedarray_t<T>> {
+  static constexpr bool labeled = true;
+
+  static constexpr auto label = js_typedarray_info_t<T>::label;
+
+  static inline auto
+  is(js_env_t *env, js_value_t *value, bool &result) {
+    return js_is_typedarray<T>(env, value, result);
+  }
+};
+
+static constexpr auto
+js_signature_label(js_value_type_t signature) {
+  switch (js_typeof_signature(signature)) {
+  case js_undefined:
+    return "undefined";
+  case js_boolean:
+    return "boolean";
+  case js_number:
+    return "number";
+  case js_string:
+    return "string";
+  case js_symbol:
+    return "symbol";
+  case js_function:
+    return "function";
+  case js_external:
+    return "external";
+  case js_bigint:
+    return "bigint";
+  default:
+    return "object";
+  }
+}
+
+template <typename T>
+static inline int
+js_check_type(js_env_t *env, js_value_t *value, bool &result) {
+  if constexpr (js_argument_check_t<T>::labeled) {
+    return js_argument_check_t<T>::is(env, value, result);
+  } else {
+    int err;
+
+    js_value_type_t type;
+    err = js_typeof(env, value, &type);
+    if (err < 0) return err;
+
+    result = js_typeof_signature(type) == js_typeof_signature(js_type_info_t<T>::signature);
+
+    return 0;
+  }
+}
+
+template <typename... T>
+struct js_type_label_t {
+  static constexpr std::string_view separator = " | ";
+
+  static constexpr std::array<std::string_view, sizeof...(T)> labels = {
+    [] {
+      if constexpr (js_argument_check_t<T>::labeled) return std::string_view(js_argument_check_t<T>::label);
+      else return std::string_view(js_signature_label(js_type_info_t<T>::signature));
+    }()...
+  };
+
+  static constexpr size_t length = [] {
+    size_t length = separator.size() * (labels.size() - 1);
+
+    for (auto label : labels) length += label.size();
+
+    return length;
+  }();
+
+  static constexpr auto buffer = [] {
+    std::array<char, length + 1> buffer{};
+
+    auto it = buffer.begin();
+
+    for (size_t i = 0; i < labels.size(); i++) {
+      if (i > 0) it = std::copy(separator.begin(), separator.end(), it);
+
+      it = std::copy(labels[i].begin(), labels[i].end(), it);
+    }
+
+    return buffer;
+  }();
+
+  static constexpr std::string_view label = std::string_view(buffer.data(), length);
+};
+
+template <>
+struct js_argument_check_t<std::monostate> {
+  static constexpr bool labeled = true;
+
+  static constexpr auto label = "undefined";
+
+  static inline int
+  is(js_env_t *env, js_value_t *value, bool &result) {
+    int err;
+
+    js_value_type_t type;
+    err = js_typeof(env, value, &type);
+    if (err < 0) return err;
+
+    result = js_typeof_signature(type) == js_undefined;
+
+    return 0;
+  }
+};
+
+template <typename T>
+struct js_argument_check_t<std::optional<T>> {
+  static constexpr bool labeled = true;
+
+  static constexpr auto label = js_type_label_t<T, std::monostate>::label;
+
+  static inline int
+  is(js_env_t *env, js_value_t *value, bool &result) {
+    int err;
+
+    err = js_check_type<std::monostate>(env, value, result);
+    if (err < 0) return err;
+
+    if (result) return 0;
+
+    return js_check_type<T>(env, value, result);
+  }
+};
+
+template <typename... T>
+struct js_argument_check_t<std::variant<T...>> {
+  static constexpr bool labeled = true;
+
+  static constexpr auto label = js_type_label_t<T...>::label;
+
+  static inline int
+  is(js_env_t *env, js_value_t *value, bool &result) {
+    int err;
+
+    result = false;
+
+    if ((((err = js_check_type<T>(env, value, result)) < 0 || result) || ...)) return err;
+
+    return 0;
+  }
+};
+
+template <typename T>
+static constexpr auto
+js_is_typed() {
+  if constexpr (requires { js_type_info_t<T>::typed; }) return js_type_info_t<T>::typed;
+  else return true;
+}
+
+template <>
+struct js_type_info_t<std::monostate> {
+  using type = js_value_t *;
+
+  static constexpr auto signature = js_undefined;
+
+  template <bool checked>
+  static auto
+  marshall(js_env_t *env, const std::monostate &, js_value_t *&result) {
+    return js_get_undefined(env, &result);
+  }
+
+  template <bool checked>
+  static int
+  unmarshall(js_env_t *env, js_value_t *value, std::monostate &) {
+    if constexpr (checked) {
+      int err;
+
+      js_value_type_t type;
+      err = js_typeof(env, value, &type);
+      if (err < 0) return err;
+
+      if (js_typeof_signature(type) != js_undefined) {
+        err = js_throw_type_error(env, nullptr, "Value is not of type 'undefined'");
+        assert(err == 0);
+
+        return js_pending_exception;
+      }
+    }
+
+    return 0;
+  }
+};
+
+template <typename T>
+struct js_type_info_t<std::optional<T>> {
+  using type = js_value_t *;
+
+  static constexpr auto signature = js_object;
+
+  static constexpr bool typed = false;
+
+  template <bool checked>
+  static auto
+  marshall(js_env_t *env, const std::optional<T> &value, js_value_t *&result) {
+    if (value) return js_type_info_t<T>::template marshall<checked>(env, *value, result);
+
+    return js_get_undefined(env, &result);
+  }
+
+  template <bool checked>
+  static auto
+  unmarshall(js_env_t *env, js_value_t *value, std::optional<T> &result) {
+    int err;
+
+    js_value_type_t type;
+    err = js_typeof(env, value, &type);
+    if (err < 0) return err;
+
+    if (js_typeof_signature(type) == js_undefined) {
+      result = std::nullopt;
+
+      return 0;
+    }
+
+    T unmarshalled;
+    err = js_type_info_t<T>::template unmarshall<checked>(env, value, unmarshalled);
+    if (err < 0) return err;
+
+    result = std::move(unmarshalled);
+
+    return 0;
+  }
+};
+
+template <typename... T>
+struct js_type_info_t<std::variant<T...>> {
+  using type = js_value_t *;
+
+  static constexpr auto signature = js_object;
+
+  static constexpr bool typed = false;
+
+  template <bool checked>
+  static auto
+  marshall(js_env_t *env, const std::variant<T...> &value, js_value_t *&result) {
+    return std::visit(
+      [&](const auto &alternative) {
+        return js_type_info_t<std::decay_t<decltype(alternative)>>::template marshall<checked>(env, alternative, result);
+      },
+      value
+    );
+  }
+
+  template <bool checked, size_t I>
+  static int
+  unmarshall(js_env_t *env, js_value_t *value, std::variant<T...> &result, bool &matched) {
+    int err;
+
+    using alternative = std::variant_alternative_t<I, std::variant<T...>>;
+
+    err = js_check_type<alternative>(env, value, matched);
+    if (err < 0 || !matched) return err;
+
+    alternative unmarshalled;
+    err = js_type_info_t<alternative>::template unmarshall<checked>(env, value, unmarshalled);
+    if (err < 0) return err;
+
+    result.template emplace<I>(std::move(unmarshalled));
+
+    return 0;
+  }
+
+  template <bool checked, size_t... I>
+  static int
+  unmarshall(js_env_t *env, js_value_t *value, std::variant<T...> &result, std::index_sequence<I...>) {
+    int err;
+
+    bool matched = false;
+
+    if ((((err = unmarshall<checked, I>(env, value, result, matched)) < 0 || matched) || ...)) return err;
+
+    auto message = "Value is not of type '" + std::string(js_type_label_t<T...>::label) + "'";
+
+    err = js_throw_type_error(env, nullptr, message.c_str());
+    assert(err == 0);
+
+    return js_pending_exception;
+  }
+
+  template <bool checked>
+  static auto
+  unmarshall(js_env_t *env, js_value_t *value, std::variant<T...> &result) {
+    return unmarshall<checked>(env, value, result, std::index_sequence_for<T...>());
+  }
+};
+
+template <auto getter, auto setter = nullptr>
+struct js_accessor_t {};
+
+template <typename T>
+struct js_property_t {
+  std::string_view name;
+  js_name_t key;
+  T value;
+  int attributes;
+
+  js_property_t(std::string_view name, T value, int attributes = js_writable | js_enumerable | js_configurable) : name(name), key(), value(value), attributes(attributes) {}
+
+  js_property_t(const js_name_t &key, T value, int attributes = js_writable | js_enumerable | js_configurable) : name(), key(key), value(value), attributes(attributes) {}
+};
+
+template <auto getter, auto setter>
+struct js_property_t<js_accessor_t<getter, setter>> {
+  std::string_view name;
+  js_name_t key;
+  int attributes;
+
+  js_property_t(std::string_view name, int attributes = js_enumerable | js_configurable) : name(name), key(), attributes(attributes) {}
+
+  js_property_t(const js_name_t &key, int attributes = js_enumerable | js_configurable) : name(), key(key), attributes(attributes) {}
+};
+
+template <typename T>
+static inline auto
+js_marshall_typed_value(T value) {
+  int err;
+
+  typename js_type_info_t<T>::type result;
+  err = js_type_info_t<T>::marshall(value, result);
+  if (err < 0) throw err;
+
+  return result;
+}
+
+template <bool checked = js_is_debug, typename T>
+static inline auto
+js_marshall_typed_value(js_env_t *env, T value) {
+  int err;
+
+  typename js_type_info_t<T>::type result;
+  err = js_type_info_t<T>::template marshall<checked>(env, value, result);
+  if (err < 0) throw err;
+
+  return result;
+}
+
+template <bool checked = js_is_debug, typename T>
+static inline auto
+js_marshall_untyped_value(js_env_t *env, T value) {
+  int err;
+
+  js_value_t *result;
+  err = js_type_info_t<T>::template marshall<checked>(env, value, result);
+  if (err < 0) throw err;
+
+  return result;
+}
+
+template <bool checked = js_is_debug>
+static inline auto
+js_marshall_untyped_value(js_env_t *env) {
+  int err;
+
+  js_value_t *result;
+  err = js_type_info_t<void>::template marshall<checked>(env, result);
+  if (err < 0) throw err;
+
+  return result;
+}
+
+template <typename T>
+static inline auto
+js_unmarshall_typed_value(typename js_type_info_t<T>::type value) {
+  int err;
+
+  T result;
+  err = js_type_info_t<T>::unmarshall(value, result);
+  if (err < 0) throw err;
+
+  return result;
+}
+
+template <bool checked = js_is_debug, typename T>
+static inline auto
+js_unmarshall_typed_value(js_env_t *env, typename js_type_info_t<T>::type value) {
+  int err;
+
+  T result;
+  err = js_type_info_t<T>::template unmarshall<checked>(env, value, result);
+  if (err < 0) throw err;
+
+  return result;
+}
+
+template <bool checked = js_is_debug, typename T>
+static inline auto
+js_unmarshall_untyped_value(js_env_t *env, js_value_t *value) {
+  int err;
+
+  T result;
+  err = js_type_info_t<T>::template unmarshall<checked>(env, value, result);
+  if (err < 0) throw err;
+
+  return result;
+}
+
+template <typename...>
+struct js_argument_info_t;
+
+template <>
+struct js_argument_info_t<> {
+  static constexpr bool has_receiver = false;
+};
+
+template <typename T, typename... R>
+struct js_argument_info_t<T, R...> {
+  static constexpr bool has_receiver = std::is_same<T, js_receiver_t>();
+};
+
+template <size_t position, typename T>
+struct js_argument_error_t {
+  static constexpr std::string_view prefix = "Argument ";
+
+  static constexpr std::string_view infix = " must be of type '";
+
+  static constexpr std::string_view suffix = "'";
+
+  static constexpr std::string_view label = js_argument_check_t<T>::label;
+
+  static constexpr size_t digits = [] {
+    size_t digits = 1;
+
+    for (auto n = position; n >= 10; n /= 10) digits++;
+
+    return digits;
+  }();
+
+  static constexpr auto message = [] {
+    std::array<char, prefix.size() + digits + infix.size() + label.size() + suffix.size() + 1> message{};
+
+    auto it = std::copy(prefix.begin(), prefix.end(), message.begin());
+
+    for (auto n = position, i = digits; i > 0; n /= 10, i--) it[i - 1] = char('0' + n % 10);
+
+    it = std::copy(infix.begin(), infix.end(), it + digits);
+    it = std::copy(label.begin(), label.end(), it);
+    it = std::copy(suffix.begin(), suffix.end(), it);
+
+    return message;
+  }();
+};
+
+template <size_t position, typename T>
+static inline int
+js_check_argument(js_env_t *env, js_value_t *value) {
+  int err;
+
+  bool is_type;
+  err = js_argument_check_t<T>::is(env, value, is_type);
+  if (err < 0) return err;
+
+  if (is_type) return 0;
+
+  err = js_throw_type_error(env, nullptr, js_argument_error_t<position, T>::message.data());
+  assert(err == 0);
+
+  return js_pending_exception;
+}
+
+template <typename T>
+struct js_argument_commit_t {
+  static constexpr bool deferred = false;
+
+  static inline auto
+  check(js_env_t *, T &) {
+    return 0;
+  }
+
+  static inline auto
+  commit(js_env_t *, T &) {
+    return 0;
+  }
+};
+
+template <typename T>
+struct js_argument_commit_t<js_transfer_t<std::span<T>>> {
+  static constexpr bool deferred = true;
+
+  static inline auto
+  check(js_env_t *env, js_transfer_t<std::span<T>> &argument) {
+    return js_check_transfer(env, argument.arraybuffer);
+  }
+
+  static inline auto
+  commit(js_env_t *env, js_transfer_t<std::span<T>> &argument) {
+    return js_detach_arraybuffer(env, argument.arraybuffer);
+  }
+};
+
+template <bool checked, size_t position, typename T>
+static inline auto
+js_unmarshall_argument(js_env_t *env, js_value_t *value) {
+  constexpr auto labeled = checked && js_argument_check_t<T>::labeled;
+
+  if constexpr (labeled) {
+    int err;
+    err = js_check_argument<position, T>(env, value);
+    if (err < 0) throw err;
+  }
+
+  if constexpr (js_argument_commit_t<T>::deferred) {
+    int err;
+
+    T result;
+    err = js_type_info_t<T>::template prepare<checked && !labeled>(env, value, result);
+    if (err < 0) throw err;
+
+    return result;
+  } else {
+    return js_unmarshall_untyped_value<checked && !labeled, T>(env, value);
+  }
+}
+
+template <bool checked, size_t offset, typename... A, size_t... I>
+static inline auto
+js_unmarshall_arguments(js_env_t *env, js_value_t *const argv[], std::index_sequence<I...>) {
+  std::tuple<A...> args{js_unmarshall_argument<checked, I + offset, A>(env, argv[I])...};
+
+  if constexpr ((js_argument_commit_t<A>::deferred || ...)) {
+    int err;
+
+    if (!(((err = js_argument_commit_t<A>::check(env, std::get<I>(args))) == 0) && ...)) throw err;
+
+    if (!(((err = js_argument_commit_t<A>::commit(env, std::get<I>(args))) == 0) && ...)) throw err;
+  }
+
+  return args;
+}
+
+template <auto fn>
+struct js_typed_callback_t;
+
+template <typename R, typename... A, R fn(A...)>
+struct js_typed_callback_t<fn> {
+  template <bool checked, bool scoped>
+  static inline auto
+  create() {
+    return +[](typename js_type_info_t<A>::type... args, js_typed_callback_info_t *info) -> typename js_type_info_t<R>::type {
+      return js_marshall_typed_value<R>(fn(js_unmarshall_typed_value<A>(args)...));
+    };
+  }
+};
+
+template <typename R, typename... A, R fn(js_env_t *, A...)>
+struct js_typed_callback_t<fn> {
+  template <bool checked, bool scoped>
+  static inline auto
+  create() {
+    return +[](typename js_type_info_t<A>::type... args, js_typed_callback_info_t *info) -> typename js_type_info_t<R>::type {
+      int err;
+
+      js_env_t *env;
+      err = js_get_typed_callback_info(info, &env, nullptr);
+      assert(err == 0);
+
+      js_escapable_handle_scope_t *scope;
+
+      if constexpr (scoped) {
+        err = js_open_escapable_handle_scope(env, &scope);
+        assert(err == 0);
+      }
+
+      typename js_type_info_t<R>::type result;
+
+      try {
+        result = js_marshall_typed_value<checked, R>(env, fn(env, js_unmarshall_typed_value<checked, A>(env, args)...));
+
+        if constexpr (scoped && std::is_same<decltype(result), js_value_t *>()) {
+          err = js_escape_handle(env, scope, result, &result);
+          assert(err == 0);
+        }
+      } catch (int err) {
+        assert(err != 0);
+      }
+
+      if constexpr (scoped) {
+        err = js_close_escapable_handle_scope(env, scope);
+        assert(err == 0);
+      }
+
+      return result;
+    };
+  }
+};
+
+template <typename... A, void fn(A...)>
+struct js_typed_callback_t<fn> {
+  template <bool checked, bool scoped>
+  static inline auto
+  create() {
+    return +[](typename js_type_info_t<A>::type... args, js_typed_callback_info_t *info) -> void {
+      fn(js_unmarshall_typed_value<A>(args)...);
+    };
+  }
+};
+
+template <typename... A, void fn(js_env_t *, A...)>
+struct js_typed_callback_t<fn> {
+  template <bool checked, bool scoped>
+  static inline auto
+  create() {
+    return +[](typename js_type_info_t<A>::type... args, js_typed_callback_info_t *info) -> void {
+      int err;
+
+      js_env_t *env;
+      err = js_get_typed_callback_info(info, &env, nullptr);
+      assert(err == 0);
+
+      js_handle_scope_t *scope;
+
+      if constexpr (scoped) {
+        err = js_open_handle_scope(env, &scope);
+        assert(err == 0);
+      }
+
+      try {
+        fn(env, js_unmarshall_typed_value<checked, A>(env, args)...);
+      } catch (int err) {
+        assert(err != 0);
+      }
+
+      if constexpr (scoped) {
+        err = js_close_handle_scope(env, scope);
+        assert(err == 0);
+      }
+    };
+  }
+};
+
+template <auto fn>
+struct js_untyped_callback_t;
+
+template <typename R, typename... A, R fn(A...)>
+struct js_untyped_callback_t<fn> {
+  template <bool checked, bool scoped, size_t... I>
+  static inline auto
+  create(std::index_sequence<I...>) {
+    return +[](js_env_t *env, js_callback_info_t *info) -> js_value_t * {
+      int err;
+
+      js_handle_scope_t *scope;
+
+      if constexpr (scoped) {
+        err = js_open_handle_scope(env, &scope);
+        assert(err == 0);
+      }
+
+      size_t argc = sizeof...(A);
+      js_value_t *argv[sizeof...(A)];
+
+      if constexpr (js_argument_info_t<A...>::has_receiver) {
+        argc--;
+
+        err = js_get_callback_info(env, info, &argc, &argv[1], &argv[0], nullptr);
+        assert(err == 0);
+
+        argc++;
+      } else {
+        err = js_get_callback_info(env, info, &argc, argv, nullptr, nullptr);
+        assert(err == 0);
+      }
+
+      assert(argc == sizeof...(A));
+
+      js_value_t *result;
+
+      try {
+        auto args = js_unmarshall_arguments<checked, !js_argument_info_t<A...>::has_receiver, A...>(env, argv, std::index_sequence<I...>());
+
+        result = js_marshall_untyped_value<checked, R>(env, fn(std::get<I>(std::move(args))...));
+      } catch (int err) {
+        assert(err != 0);
+      }
+
+      if constexpr (scoped) {
+        err = js_close_handle_scope(env, scope);
+        assert(err == 0);
+      }
+
+      return result;
+    };
+  }
+
+  template <bool checked, bool scoped>
+  static inline auto
+  create() {
+    return create<checked, scoped>(std::index_sequence_for<A...>());
+  }
+};
+
+template <typename R, typename... A, R fn(js_env_t *, A...)>
+struct js_untyped_callback_t<fn> {
+  template <bool checked, bool scoped, size_t... I>
+  static inline auto
+  create(std::index_sequence<I...>) {
+    return +[](js_env_t *env, js_callback_info_t *info) -> js_value_t * {
+      int err;
+
+      js_escapable_handle_scope_t *scope;
+
+      if constexpr (scoped) {
+        err = js_open_escapable_handle_scope(env, &scope);
+        assert(err == 0);
+      }
+
+      size_t argc = sizeof...(A);
+      js_value_t *argv[sizeof...(A)];
+
+      if constexpr (js_argument_info_t<A...>::has_receiver) {
+        argc--;
+
+        err = js_get_callback_info(env, info, &argc, &argv[1], &argv[0], nullptr);
+        assert(err == 0);
+
+        argc++;
+      } else {
+        err = js_get_callback_info(env, info, &argc, argv, nullptr, nullptr);
+        assert(err == 0);
+      }
+
+      assert(argc == sizeof...(A));
+
+      js_value_t *result;
+
+      try {
+        auto args = js_unmarshall_arguments<checked, !js_argument_info_t<A...>::has_receiver, A...>(env, argv, std::index_sequence<I...>());
+
+        result = js_marshall_untyped_value<checked, R>(env, fn(env, std::get<I>(std::move(args))...));
+
+        if constexpr (scoped) {
+          err = js_escape_handle(env, scope, result, &result);
+          assert(err == 0);
+        }
+      } catch (int err) {
+        assert(err != 0);
+      }
+
+      if constexpr (scoped) {
+        err = js_close_escapable_handle_scope(env, scope);
+        assert(err == 0);
+      }
+
+      return result;
+    };
+  }
+
+  template <bool checked, bool scoped>
+  static inline auto
+  create() {
+    return create<checked, scoped>(std::index_sequence_for<A...>());
+  }
+};
+
+template <typename... A, void fn(A...)>
+struct js_untyped_callback_t<fn> {
+  template <bool checked, bool scoped, size_t... I>
+  static inline auto
+  create(std::index_sequence<I...>) {
+    return +[](js_env_t *env, js_callback_info_t *info) -> js_value_t * {
+      int err;
+
+      js_handle_scope_t *scope;
+
+      if constexpr (scoped) {
+        err = js_open_handle_scope(env, &scope);
+        assert(err == 0);
+      }
+
+      size_t argc = sizeof...(A);
+      js_value_t *argv[sizeof...(A)];
+
+      if constexpr (js_argument_info_t<A...>::has_receiver) {
+        argc--;
+
+        err = js_get_callback_info(env, info, &argc, &argv[1], &argv[0], nullptr);
+        assert(err == 0);
+
+        argc++;
+      } else {
+        err = js_get_callback_info(env, info, &argc, argv, nullptr, nullptr);
+        assert(err == 0);
+      }
+
+      assert(argc == sizeof...(A));
+
+      try {
+        auto args = js_unmarshall_arguments<checked, !js_argument_info_t<A...>::has_receiver, A...>(env, argv, std::index_sequence<I...>());
+
+        fn(std::get<I>(std::move(args))...);
+      } catch (int err) {
+        assert(err != 0);
+      }
+
+      if constexpr (scoped) {
+        err = js_close_handle_scope(env, scope);
+        assert(err == 0);
+      }
+
+      return js_marshall_untyped_value<checked>(env);
+    };
+  }
+
+  template <bool checked, bool scoped>
+  static inline auto
+  create() {
+    return create<checked, scoped>(std::index_sequence_for<A...>());
+  }
+};
+
+template <typename... A, void fn(js_env_t *, A...)>
+struct js_untyped_callback_t<fn> {
+  template <bool checked, bool scoped, size_t... I>
+  static inline auto
+  create(std::index_sequence<I...>) {
+    return +[](js_env_t *env, js_callback_info_t *info) -> js_value_t * {
+      int err;
+
+      js_handle_scope_t *scope;
+
+      if constexpr (scoped) {
+        err = js_open_handle_scope(env, &scope);
+        assert(err == 0);
+      }
+
+      size_t argc = sizeof...(A);
+      js_value_t *argv[sizeof...(A)];
+
+      if constexpr (js_argument_info_t<A...>::has_receiver) {
+        argc--;
+
+        err = js_get_callback_info(env, info, &argc, &argv[1], &argv[0], nullptr);
+        assert(err == 0);
+
+        argc++;
+      } else {
+        err = js_get_callback_info(env, info, &argc, argv, nullptr, nullptr);
+        assert(err == 0);
+      }
+
+      assert(argc == sizeof...(A));
+
+      try {
+        auto args = js_unmarshall_arguments<checked, !js_argument_info_t<A...>::has_receiver, A...>(env, argv, std::index_sequence<I...>());
+
+        fn(env, std::get<I>(std::move(args))...);
+      } catch (int err) {
+        assert(err != 0);
+      }
+
+      if constexpr (scoped) {
+        err = js_close_handle_scope(env, scope);
+        assert(err == 0);
+      }
+
+      return js_marshall_untyped_value<checked>(env);
+    };
+  }
+
+  template <bool checked, bool scoped>
+  static inline auto
+  create() {
+    return create<checked, scoped>(std::index_sequence_for<A...>());
+  }
+};
+
+template <auto fn, bool checked = js_is_debug, bool scoped = true>
+static inline auto
+js_typed_callback() {
+  return js_typed_callback_t<fn>::template create<checked, scoped>();
+}
+
+template <auto fn, bool checked = js_is_debug, bool scoped = true>
+static inline auto
+js_untyped_callback() {
+  return js_untyped_callback_t<fn>::template create<checked, scoped>();
+}
+
+template <auto fn>
+struct js_function_info_t;
+
+template <typename R, typename... A, R fn(A...)>
+struct js_function_info_t<fn> {
+  using type = R(A...);
+  using result = R;
+  using arguments = std::tuple<A...>;
+
+  template <bool checked, bool scoped>
+  static auto
+  marshall(js_env_t *env, const char *name, size_t len, js_function_t<R, A...> &result) {
+    auto untyped = js_untyped_callback<fn, checked, scoped>();
+
+    if constexpr (!(js_is_typed<R>() && ... && js_is_typed<A>())) {
+      return js_create_function(env, name, len, untyped, nullptr, &result.value);
+    } else {
+      auto typed = js_typed_callback<fn, checked, scoped>();
+
+      js_callback_signature_t signature;
+
+      int args[] = {
+        js_type_info_t<A>::signature...
+      };
+
+      signature.version = 0;
+      signature.result = js_type_info_t<R>::signature;
+      signature.args_len = sizeof...(A);
+      signature.args = args;
+
+      return js_create_typed_function(env, name, len, untyped, &signature, (const void *) typed, nullptr, &result.value);
+    }
+  }
+
+  template <bool checked, bool scoped>
+  static auto
+  marshall(js_env_t *env, const char *name, size_t len, js_handle_t &result) {
+    int err;
+
+    js_function_t<R, A...> value;
+    err = marshall<checked, scoped>(env, name, len, value);
+    if (err < 0) return err;
+
+    result = value;
+
+    return 0;
+  }
+};
+
+template <typename R, typename... A, R fn(js_env_t *, A...)>
+struct js_function_info_t<fn> {
+  using type = R(js_env_t *, A...);
+  using result = R;
+  using arguments = std::tuple<A...>;
+
+  template <bool checked, bool scoped>
+  static auto
+  marshall(js_env_t *env, const char *name, size_t len, js_function_t<R, A...> &result) {
+    auto untyped = js_untyped_callback<fn, checked, scoped>();
+
+    if constexpr (!(js_is_typed<R>() && ... && js_is_typed<A>())) {
+      return js_create_function(env, name, len, untyped, nullptr, &result.value);
+    } else {
+      auto typed = js_typed_callback<fn, checked, scoped>();
+
+      js_callback_signature_t signature;
+
+      int args[] = {
+        js_type_info_t<A>::signature...
+      };
+
+      signature.version = 0;
+      signature.result = js_type_info_t<R>::signature;
+      signature.args_len = sizeof...(A);
+      signature.args = args;
+
+      return js_create_typed_function(env, name, len, untyped, &signature, (const void *) typed, nullptr, &result.value);
+    }
+  }
+
+  template <bool checked, bool scoped>
+  static auto
+  marshall(js_env_t *env, const char *name, size_t len, js_handle_t &result) {
+    int err;
+
+    js_function_t<R, A...> value;
+    err = marshall<checked, scoped>(env, name, len, value);
+    if (err < 0) return err;
+
+    result = value;
+
+    return 0;
+  }
+};
+
+template <auto fn, bool checked = js_is_debug, bool scoped = true, typename R, typename... A>
+static inline auto
+js_create_function(js_env_t *env, const char *name, size_t len, js_function_t<R, A...> &result) {
+  return js_function_info_t<fn>::template marshall<checked, scoped>(env, name, len, result);
+}
+
+template <auto fn, bool checked = js_is_debug, bool scoped = true, typename R, typename... A>
+static inline auto
+js_create_function(js_env_t *env, const std::string &name, js_function_t<R, A...> &result) {
+  return js_function_info_t<fn>::template marshall<checked, scoped>(env, name.data(), name.size(), result);
+}
+
+template <auto fn, bool checked = js_is_debug, bool scoped = true, typename R, typename... A>
+static inline auto
+js_create_function(js_env_t *env, js_function_t<R, A...> &result) {
+  return js_function_info_t<fn>::template marshall<checked, scoped>(env, nullptr, 0, result);
+}
+
+template <auto fn, bool checked = js_is_debug, bool scoped = true>
+static inline auto
+js_create_function(js_env_t *env, const char *name, size_t len, js_handle_t &result) {
+  return js_function_info_t<fn>::template marshall<checked, scoped>(env, name, len, result);
+}
+
+template <auto fn, bool checked = js_is_debug, bool scoped = true>
+static inline auto
+js_create_function(js_env_t *env, std::string name, js_handle_t &result) {
+  return js_function_info_t<fn>::template marshall<checked, scoped>(env, name.data(), name.length(), result);
+}
+
+template <auto fn, bool checked = js_is_debug, bool scoped = true>
+static inline auto
+js_create_function(js_env_t *env, js_handle_t &result) {
+  return js_function_info_t<fn>::template marshall<checked, scoped>(env, nullptr, 0, result);
+}
+
+template <bool checked = js_is_debug, typename... A>
+static inline auto
+js_call_function(js_env_t *env, const js_function_t<void, A...> &function, const A &...args) {
+  int err;
+
+  size_t argc = sizeof...(A);
+
+  try {
+    js_value_t *argv[] = {
+      js_marshall_untyped_value<checked, A>(env, args...)...
+    };
+
+    js_value_t *receiver;
+
+    size_t offset = 0;
+
+    if constexpr (js_argument_info_t<A...>::has_receiver) {
+      receiver = argv[0];
+      offset = 1;
+    } else {
+      err = js_get_global(env, &receiver);
+      assert(err == 0);
+    }
+
+    return js_call_function(env, receiver, function.value, argc - offset, &argv[offset], nullptr);
+  } catch (int err) {
+    return err;
+  }
+}
+
+template <bool checked = js_is_debug, typename R, typename... A>
+static inline auto
+js_call_function(js_env_t *env, const js_function_t<R, A...> &function, const A &...args, R &result) {
+  int err;
+
+  size_t argc = sizeof...(A);
+
+  try {
+    js_value_t *argv[] = {
+      js_marshall_untyped_value<checked, A>(env, args...)...
+    };
+
+    js_value_t *receiver;
+
+    size_t offset = 0;
+
+    if constexpr (js_argument_info_t<A...>::has_receiver) {
+      receiver = argv[0];
+      offset = 1;
+    } else {
+      err = js_get_global(env, &receiver);
+      assert(err == 0);
+    }
+
+    js_value_t *value;
+    err = js_call_function(env, receiver, function.value, argc - offset, &argv[offset], &value);
+    if (err < 0) return err;
+
+    result = js_unmarshall_untyped_value<checked, R>(env, value);
+
+    return 0;
+  } catch (int err) {
+    return err;
+  }
+}
+
+static inline auto
+js_create_object(js_env_t *env, js_object_t &result) {
+  return js_create_object(env, &result.value);
+}
+
+template <typename... T>
+static inline auto
+js_create_object(js_env_t *env, js_object_t &result, const js_property_t<T>... properties) {
+  int err;
+  err = js_create_object(env, result);
+  if (err < 0) return err;
+
+  return js_define_properties(env, result, properties...);
+}
+
+template <typename... T>
+static inline auto
+js_create_frozen_object(js_env_t *env, js_object_t &result, const js_property_t<T>... properties) {
+  int err;
+  err = js_create_object(env, result, properties...);
+  if (err < 0) return err;
+
+  return js_object_freeze(env, result.value);
+}
+
+static inline auto
+js_create_array(js_env_t *env, js_array_t &result) {
+  return js_create_array(env, &result.value);
+}
+
+static inline auto
+js_create_array(js_env_t *env, size_t len, js_array_t &result) {
+  return js_create_array_with_length(env, len, &result.value);
+}
+
+template <typename T, size_t N>
+static inline auto
+js_create_array(js_env_t *env, const T values[N], js_array_t &result) {
+  int err;
+  err = js_create_array(env, N, result);
+  if (err < 0) return err;
+
+  return js_set_array_elements(env, result, values);
+}
+
+template <typename T, size_t N>
+static inline auto
+js_create_array(js_env_t *env, const std::array<T, N> values, js_array_t &result) {
+  int err;
+  err = js_create_array(env, N, result);
+  if (err < 0) return err;
+
+  return js_set_array_elements(env, result, values);
+}
+
+template <typename T>
+static inline auto
+js_create_array(js_env_t *env, const std::vector<T> values, js_array_t &result) {
+  int err;
+  err = js_create_array(env, values.size(), result);
+  if (err < 0) return err;
+
+  return js_set_array_elements(env, result, values);
+}
+
+static inline auto
+js_create_bigint(js_env_t *env, int64_t value, js_bigint_t &result) {
+  return js_create_bigint_int64(env, value, &result.value);
+}
+
+static inline auto
+js_create_bigint(js_env_t *env, uint64_t value, js_bigint_t &result) {
+  return js_create_bigint_uint64(env, value, &result.value);
+}
+
+static inline auto
+js_create_bigint(js_env_t *env, int sign, std::span<const uint64_t> words, js_bigint_t &result) {
+  return js_create_bigint_words(env, sign, words.data(), words.size(), &result.value);
+}
+
+template <size_t N>
+static inline auto
+js_create_string(js_env_t *env, const char value[N], js_string_t &result) {
+  return js_create_string_utf8(env, value, N, &result.value);
+}
+
+static inline auto
+js_create_string(js_env_t *env, const utf8_t *value, size_t len, js_string_t &result) {
+  return js_create_string_utf8(env, value, len, &result.value);
+}
+
+static inline auto
+js_create_string(js_env_t *env, const std::string &value, js_string_t &result) {
+  return js_create_string_ascii_or_utf8(env, value.data(), value.length(), &result.value);
+}
+
+template <typename T>
+static inline auto
+js_create_arraybuffer(js_env_t *env, size_t len, T *&data, js_arraybuffer_t &result) {
+  return js_create_arraybuffer(env, len * sizeof(T), (void **) &data, &result.value);
+}
+
+template <typename T>
+static inline auto
+js_create_arraybuffer(js_env_t *env, T *&data, js_arraybuffer_t &result) {
+  return js_create_arraybuffer(env, sizeof(T), (void **) &data, &result.value);
+}
+
+static inline auto
+js_create_arraybuffer(js_env_t *env, size_t len, js_arraybuffer_t &result) {
+  return js_create_arraybuffer(env, len, nullptr, &result.value);
+}
+
+template <typename T>
+static inline auto
+js_create_arraybuffer(js_env_t *env, size_t len, js_arraybuffer_t &result) {
+  return js_create_arraybuffer(env, len * sizeof(T), nullptr, &result.value);
+}
+
+template <typename T>
+static inline auto
+js_create_arraybuffer(js_env_t *env, size_t len, std::span<T> &view, js_arraybuffer_t &result) {
+  int err;
+
+  T *data;
+  err = js_create_arraybuffer(env, len, data, result);
+  if (err < 0) return err;
+
+  view = std::span(data, len);
+
+  return 0;
+}
+
+template <typename T>
+static inline auto
+js_create_unsafe_arraybuffer(js_env_t *env, size_t len, T *&data, js_arraybuffer_t &result) {
+  return js_create_unsafe_arraybuffer(env, len * sizeof(T), (void **) &data, &result.value);
+}
+
+template <typename T>
+static inline auto
+js_create_unsafe_arraybuffer(js_env_t *env, size_t len, std::span<T> &view, js_arraybuffer_t &result) {
+  int err;
+
+  T *data;
+  err = js_create_unsafe_arraybuffer(env, len, data, result);
+  if (err < 0) return err;
+
+  view = std::span(data, len);
+
+  return 0;
+}
+
+template <typename T, size_t N>
+static inline auto
+js_create_arraybuffer(js_env_t *env, const T data[N], js_arraybuffer_t &result) {
+  int err;
+
+  std::span<T> view;
+  err = js_create_unsafe_arraybuffer(env, N, view, result);
+  if (err < 0) return err;
+
+  std::copy(data, data + N, view.begin());
+
+  return 0;
+}
+
+template <typename T, size_t N>
+static inline auto
+js_create_arraybuffer(js_env_t *env, const std::array<T, N> data, js_arraybuffer_t &result) {
+  int err;
+
+  std::span<T> view;
+  err = js_create_unsafe_arraybuffer(env, N, view, result);
+  if (err < 0) return err;
+
+  std::copy(data.begin(), data.end(), view.begin());
+
+  return 0;
+}
+
+template <typename T>
+static inline auto
+js_create_arraybuffer(js_env_t *env, const std::span<T> &data, js_arraybuffer_t &result) {
+  int err;
+
+  std::span<T> view;
+  err = js_create_unsafe_arraybuffer(env, data.size(), view, result);
+  if (err < 0) return err;
+
+  std::copy(data.begin(), data.end(), view.begin());
+
+  return 0;
+}
+
+template <typename T>
+static inline auto
+js_create_arraybuffer(js_env_t *env, const std::vector<T> &data, js_arraybuffer_t &result) {
+  int err;
+
+  std::span<T> view;
+  err = js_create_unsafe_arraybuffer(env, data.size(), view, result);
+  if (err < 0) return err;
+
+  std::copy(data.begin(), data.end(), view.begin());
+
+  return 0;
+}
+
+template <typename T>
+static inline auto
+js_create_external_arraybuffer(js_env_t *env, T *data, size_t len, js_arraybuffer_t &result) {
+  return js_create_external_arraybuffer(env, (void *) data, len * sizeof(T), nullptr, nullptr, &result.value);
+}
+
+template <typename T>
+static inline auto
+js_create_external_arraybuffer(js_env_t *env, std::vector<T> &&data, js_arraybuffer_t &result) {
+  int err;
+
+  struct external_t {
+    std::vector<T> data;
+    js_external_memory_t memory;
+  };
+
+  auto len = data.size();
+
+  auto slack = (data.capacity() - len) * sizeof(T);
+
+  auto external = new external_t{std::move(data), js_external_memory_t(env, slack)};
+
+  auto finalize = +[](js_env_t *, void *, void *hint) {
+    delete static_cast<external_t *>(hint);
+  };
+
+  err = js_create_external_arraybuffer(env, (void *) external->data.data(), len * sizeof(T), finalize, (void *) external, &result.value);
+
+  if (err < 0) {
+    data = std::move(external->data);
+
+    delete external;
+
+    return err;
+  }
+
+  return 0;
+}
+
+template <typename T>
+static inline int
+js_create_external_arraybuffer(js_env_t *env, std::unique_ptr<T> &&data, js_arraybuffer_t &result) {
+  static_assert(std::is_trivially_copyable<T>() && !std::is_array<T>());
+
+  int err;
+
+  if (data == nullptr) {
+    err = js_throw_type_error(env, nullptr, "Value is null");
+    assert(err == 0);
+
+    return js_pending_exception;
+  }
+
+  auto size = js_external_info_t<T>::size(*data);
+
+  auto memory = new js_external_memory_t(env, size > sizeof(T) ? size - sizeof(T) : 0);
+
+  auto finalize = +[](js_env_t *, void *data, void *hint) {
+    delete static_cast<T *>(data);
+    delete static_cast<js_external_memory_t *>(hint);
+  };
+
+  err = js_create_external_arraybuffer(env, (void *) data.get(), sizeof(T), finalize, (void *) memory, &result.value);
+
+  if (err < 0) {
+    delete memory;
+
+    return err;
+  }
+
+  data.release();
+
+  return 0;
+}
+
+template <typename T>
+static inline int
+js_create_external_arraybuffer(js_env_t *env, std::unique_ptr<T[]> &&data, size_t len, js_arraybuffer_t &result) {
+  static_assert(std::is_trivially_copyable<T>());
+
+  int err;
+
+  if (data == nullptr) {
+    err = js_throw_type_error(env, nullptr, "Value is null");
+    assert(err == 0);
+
+    return js_pending_exception;
+  }
+
+  auto finalize = +[](js_env_t *, void *data, void *) {
+    delete[] static_cast<T *>(data);
+  };
+
+  err = js_create_external_arraybuffer(env, (void *) data.get(), len * sizeof(T), finalize, nullptr, &result.value);
+  if (err < 0) return err;
+
+  data.release();
+
+  return 0;
+}
+
+static inline auto
+js_resize_external_memory(js_env_t *env, js_external_memory_t &memory, size_t size) {
+  int err;
+
+  auto change = int64_t(size) - memory.size;
+
+  if (change == 0) return 0;
+
+  err = js_adjust_external_memory(env, change, nullptr);
+  if (err < 0) return err;
+
+  memory.env = env;
+  memory.size = int64_t(size);
+
+  return 0;
+}
+
+template <typename T>
+static inline auto
+js_create_typedarray(js_env_t *env, size_t len, const js_arraybuffer_t &arraybuffer, size_t offset, js_typedarray_t<T> &result) {
+  return js_create_typedarray(env, js_typedarray_info_t<T>::type, len, arraybuffer.value, offset, &result.value);
+}
+
+template <typename T>
+static inline auto
+js_create_typedarray(js_env_t *env, size_t len, const js_arraybuffer_t &arraybuffer, js_typedarray_t<T> &result) {
+  return js_create_typedarray(env, len, arraybuffer, 0, result);
+}
+
+template <typename T>
+static inline auto
+js_create_typedarray(js_env_t *env, size_t len, const js_sharedarraybuffer_t &sharedarraybuffer, size_t offset, js_typedarray_t<T> &result) {
+  return js_create_typedarray(env, js_typedarray_info_t<T>::type, len, sharedarraybuffer.value, offset, &result.value);
+}
+
+template <typename T>
+static inline auto
+js_create_typedarray(js_env_t *env, size_t len, const js_sharedarraybuffer_t &sharedarraybuffer, js_typedarray_t<T> &result) {
+  return js_create_typedarray(env, len, sharedarraybuffer, 0, result);
+}
+
+template <typename T>
+static inline auto
+js_create_typedarray(js_env_t *env, size_t len, T *&data, js_typedarray_t<T> &result) {
+  int err;
+
+  js_arraybuffer_t arraybuffer;
+  err = js_create_arraybuffer(env, len, data, arraybuffer);
+  if (err < 0) return err;
+
+  return js_create_typedarray(env, len, arraybuffer, result);
+}
+
+template <typename T>
+static inline auto
+js_create_typedarray(js_env_t *env, size_t len, std::span<T> &view, js_typedarray_t<T> &result) {
+  int err;
+
+  js_arraybuffer_t arraybuffer;
+  err = js_create_arraybuffer(env, len, view, arraybuffer);
+  if (err < 0) return err;
+
+  return js_create_typedarray(env, len, arraybuffer, result);
+}
+
+template <typename T>
+static inline auto
+js_create_unsafe_typedarray(js_env_t *env, size_t len, T *&data, js_typedarray_t<T> &result) {
+  int err;
+
+  js_arraybuffer_t arraybuffer;
+  err = js_create_unsafe_arraybuffer(env, len, data, arraybuffer);
+  if (err < 0) return err;
+
+  return js_create_typedarray(env, len, arraybuffer, result);
+}
+
+template <typename T>
+static inline auto
+js_create_unsafe_typedarray(js_env_t *env, size_t len, std::span<T> &view, js_typedarray_t<T> &result) {
+  int err;
+
+  js_arraybuffer_t arraybuffer;
+  err = js_create_unsafe_arraybuffer(env, len, view, arraybuffer);
+  if (err < 0) return err;
+
+  return js_create_typedarray(env, len, arraybuffer, result);
+}
+
+template <typename T>
+static inline auto
+js_create_typedarray(js_env_t *env, size_t len, js_typedarray_t<T> &result) {
+  int err;
+
+  js_arraybuffer_t arraybuffer;
+  err = js_create_arraybuffer<T>(env, len, arraybuffer);
+  if (err < 0) return err;
+
+  return js_create_typedarray(env, len, arraybuffer, result);
+}
+
+template <typename T>
+static inline auto
+js_create_typedarray(js_env_t *env, T *&data, js_typedarray_t<uint8_t> &result) {
+  int err;
+
+  js_arraybuffer_t arraybuffer;
+  err = js_create_arraybuffer(env, data, arraybuffer);
+  if (err < 0) return err;
+
+  return js_create_typedarray(env, sizeof(T), arraybuffer, result);
+}
+
+template <typename T, size_t N>
+static inline auto
+js_create_typedarray(js_env_t *env, const T data[N], js_typedarray_t<T> &result) {
+  int err;
+
+  std::span<T> view;
+  err = js_create_unsafe_typedarray(env, N, view, result);
+  if (err < 0) return err;
+
+  std::copy(data, data + N, view.begin());
+
+  return 0;
+}
+
+template <typename T, size_t N>
+static inline auto
+js_create_typedarray(js_env_t *env, const std::array<T, N> data, js_typedarray_t<T> &result) {
+  int err;
+
+  std::span<T> view;
+  err = js_create_unsafe_typedarray(env, N, view, result);
+  if (err < 0) return err;
+
+  std::copy(data.begin(), data.end(), view.begin());
+
+  return 0;
+}
+
+template <typename T>
+static inline auto
+js_create_typedarray(js_env_t *env, const std::span<T> &data, js_typedarray_t<T> &result) {
+  int err;
+
+  std::span<T> view;
+  err = js_create_unsafe_typedarray(env, data.size(), view, result);
+  if (err < 0) return err;
+
+  std::copy(data.begin(), data.end(), view.begin());
+
+  return 0;
+}
+
+template <typename D, bool clamp = false, std::endian endian = std::endian::native, typename S>
+static inline auto
+js_create_typedarray(js_env_t *env, const std::span<S> &data, js_typedarray_t<D> &result) {
+  int err;
+
+  std::span<D> view;
+  err = js_create_unsafe_typedarray(env, data.size(), view, result);
+  if (err < 0) return err;
+
+  js_convert<D, clamp, endian>(data, view);
+
+  return 0;
+}
+
+template <typename T>
+static inline auto
+js_create_typedarray(js_env_t *env, const std::vector<T> &data, js_typedarray_t<T> &result) {
+  int err;
+
+  std::span<T> view;
+  err = js_create_unsafe_typedarray(env, data.size(), view, result);
+  if (err < 0) return err;
+
+  std::copy(data.begin(), data.end(), view.begin());
+
+  return 0;
+}
+
+template <typename T>
+static inline auto
+js_get_arraybuffer_info(js_env_t *env, const js_arraybuffer_t &arraybuffer, T *&data, size_t &len) {
+  int err;
+  err = js_get_arraybuffer_info(env, arraybuffer.value, (void **) &data, &len);
+  if (err < 0) return err;
+
+  assert(len % sizeof(T) == 0);
+
+  len /= sizeof(T);
+
+  return 0;
+}
+
+template <typename T>
+static inline auto
+js_get_arraybuffer_info(js_env_t *env, const js_arraybuffer_t &arraybuffer, T *&data) {
+  int err;
+
+  size_t len;
+  err = js_get_arraybuffer_info(env, arraybuffer.value, (void **) &data, &len);
+  if (err < 0) return err;
+
+  assert(len == sizeof(T));
+
+  return 0;
+}
+
+template <typename T>
+static inline auto
+js_get_arraybuffer_info(js_env_t *env, const js_arraybuffer_t &arraybuffer, std::span<T> &view) {
+  int err;
+
+  T *data;
+  size_t len;
+  err = js_get_arraybuffer_info(env, arraybuffer, data, len);
+  if (err < 0) return err;
+
+  view = std::span(data, len);
+
+  return 0;
+}
+
+static inline auto
+js_get_arraybuffer_backing_store(js_env_t *env, const js_arraybuffer_t &arraybuffer, std::shared_ptr<js_arraybuffer_backing_store_t> &result) {
+  int err;
+
+  js_arraybuffer_backing_store_t *backing_store;
+  err = js_get_arraybuffer_backing_store(env, arraybuffer.value, &backing_store);
+  if (err < 0) return err;
+
+  return js_own_backing_store(env, backing_store, result);
+}
+
+static inline auto
+js_is_detached_arraybuffer(js_env_t *env, const js_arraybuffer_t &arraybuffer, bool &result) {
+  return js_is_detached_arraybuffer(env, arraybuffer.value, &result);
+}
+
+static inline auto
+js_detach_arraybuffer(js_env_t *env, const js_arraybuffer_t &arraybuffer) {
+  return js_detach_arraybuffer(env, arraybuffer.value);
+}
+
+static inline int
+js_check_transfer(js_env_t *env, const js_arraybuffer_t &arraybuffer) {
+  int err;
+
+  bool is_detached;
+  err = js_is_detached_arraybuffer(env, arraybuffer, is_detached);
+  if (err < 0) return err;
+
+  if (is_detached) {
+    err = js_throw_type_error(env, nullptr, "ArrayBuffer is detached");
+    assert(err == 0);
+
+    return js_pending_exception;
+  }
+
+  return 0;
+}
+
+template <typename T>
+static inline int
+js_prepare_transfer(js_env_t *env, const js_arraybuffer_t &arraybuffer, js_transfer_t<std::span<T>> &result) {
+  int err;
+
+  err = js_check_transfer(env, arraybuffer);
+  if (err < 0) return err;
+
+  err = js_get_arraybuffer_backing_store(env, arraybuffer, result.backing_store);
+  if (err < 0) return err;
+
+  err = js_get_arraybuffer_info(env, arraybuffer, result.value);
+  if (err < 0) return err;
+
+  result.arraybuffer = arraybuffer;
+
+  return 0;
+}
+
+template <typename T>
+static inline int
+js_detach_arraybuffer(js_env_t *env, const js_arraybuffer_t &arraybuffer, js_transfer_t<std::span<T>> &result) {
+  int err;
+  err = js_prepare_transfer(env, arraybuffer, result);
+  if (err < 0) return err;
+
+  return js_detach_arraybuffer(env, arraybuffer);
+}
+
+static inline auto
+js_create_sharedarraybuffer(js_env_t *env, size_t len, js_sharedarraybuffer_t &result) {
+  return js_create_sharedarraybuffer(env, len, nullptr, &result.value);
+}
+
+template <typename T>
+static inline auto
+js_create_sharedarraybuffer(js_env_t *env, size_t len, T *&data, js_sharedarraybuffer_t &result) {
+  return js_create_sharedarraybuffer(env, len * sizeof(T), (void **) &data, &result.value);
+}
+
+template <typename T>
+static inline auto
+js_create_sharedarraybuffer(js_env_t *env, size_t len, std::span<T> &view, js_sharedarraybuffer_t &result) {
+  int err;
+
+  T *data;
+  err = js_create_sharedarraybuffer(env, len, data, result);
+  if (err < 0) return err;
+
+  view = std::span(data, len);
+
+  return 0;
+}
+
+static inline auto
+js_get_sharedarraybuffer_backing_store(js_env_t *env, const js_sharedarraybuffer_t &sharedarraybuffer, std::shared_ptr<js_arraybuffer_backing_store_t> &result) {
+  int err;
+
+  js_arraybuffer_backing_store_t *backing_store;
+  err = js_get_sharedarraybuffer_backing_store(env, sharedarraybuffer.value, &backing_store);
+  if (err < 0) return err;
+
+  return js_own_backing_store(env, backing_store, result);
+}
+
+static inline auto
+js_create_sharedarraybuffer(js_env_t *env, const std::shared_ptr<js_arraybuffer_backing_store_t> &backing_store, js_sharedarraybuffer_t &result) {
+  return js_create_sharedarraybuffer_with_backing_store(env, backing_store.get(), nullptr, nullptr, &result.value);
+}
+
+template <typename T>
+static inline auto
+js_create_sharedarraybuffer(js_env_t *env, const std::shared_ptr<js_arraybuffer_backing_store_t> &backing_store, std::span<T> &view, js_sharedarraybuffer_t &result) {
+  int err;
+
+  T *data;
+  size_t len;
+  err = js_create_sharedarraybuffer_with_backing_store(env, backing_store.get(), (void **) &data, &len, &result.value);
+  if (err < 0) return err;
+
+  assert(len % sizeof(T) == 0);
+
+  view = std::span(data, len / sizeof(T));
+
+  return 0;
+}
+
+template <typename T>
+static inline auto
+js_get_sharedarraybuffer_info(js_env_t *env, const js_sharedarraybuffer_t &sharedarraybuffer, T *&data, size_t &len) {
+  int err;
+  err = js_get_sharedarraybuffer_info(env, sharedarraybuffer.value, (void **) &data, &len);
+  if (err < 0) return err;
+
+  assert(len % sizeof(T) == 0);
+
+  len /= sizeof(T);
+
+  return 0;
+}
+
+template <typename T>
+static inline auto
+js_get_sharedarraybuffer_info(js_env_t *env, const js_sharedarraybuffer_t &sharedarraybuffer, std::span<T> &view) {
+  int err;
+
+  T *data;
+  size_t len;
+  err = js_get_sharedarraybuffer_info(env, sharedarraybuffer, data, len);
+  if (err < 0) return err;
+
+  view = std::span(data, len);
+
+  return 0;
+}
+
+static inline auto
+js_create_dataview(js_env_t *env, size_t len, const js_arraybuffer_t &arraybuffer, size_t offset, js_dataview_t &result) {
+  return js_create_dataview(env, len, arraybuffer.value, offset, &result.value);
+}
+
+static inline auto
+js_create_dataview(js_env_t *env, size_t len, const js_arraybuffer_t &arraybuffer, js_dataview_t &result) {
+  return js_create_dataview(env, len, arraybuffer, 0, result);
+}
+
+template <typename T>
+static inline auto
+js_get_dataview_info(js_env_t *env, const js_dataview_t &dataview, T *&data, size_t &len) {
+  int err;
+  err = js_get_dataview_info(env, dataview.value, (void **) &data, &len, nullptr, nullptr);
+  if (err < 0) return err;
+
+  assert(len % sizeof(T) == 0);
+
+  len /= sizeof(T);
+
+  return 0;
+}
+
+template <typename T>
+static inline auto
+js_get_dataview_info(js_env_t *env, const js_dataview_t &dataview, std::span<T> &view) {
+  int err;
+
+  T *data;
+  size_t len;
+  err = js_get_dataview_info(env, dataview, data, len);
+  if (err < 0) return err;
+
+  view = std::span(data, len);
+
+  return 0;
+}
+
+template <typename T>
+static inline auto
+js_get_dataview_info(js_env_t *env, const js_dataview_t &dataview, std::span<T> &view, js_arraybuffer_t &arraybuffer, size_t &offset) {
+  int err;
+
+  T *data;
+  size_t len;
+  err = js_get_dataview_info(env, dataview.value, (void **) &data, &len, &arraybuffer.value, &offset);
+  if (err < 0) return err;
+
+  assert(len % sizeof(T) == 0);
+
+  view = std::span(data, len / sizeof(T));
+
+  return 0;
+}
+
+template <typename... F>
+static inline int
+js_get_dataview_info(js_env_t *env, const js_dataview_t &dataview, js_record_view_t<F...> &view) {
+  int err;
+
+  std::span<uint8_t> data;
+  err = js_get_dataview_info(env, dataview, data);
+  if (err < 0) return err;
+
+  if (data.size() < js_record_view_t<F...>::size) {
+    err = js_throw_range_error(env, nullptr, "DataView is too small for record");
+    assert(err == 0);
+
+    return js_pending_exception;
+  }
+
+  view = js_record_view_t<F...>(data);
+
+  return 0;
+}
+
+template <typename T>
+static inline auto
+js_get_typedarray_info(js_env_t *env, js_typedarray_t<T> &typedarray, T *&data, size_t &len) {
+  return js_get_typedarray_info(env, typedarray.value, nullptr, (void **) &data, &len, nullptr, nullptr);
+}
+
+template <typename T>
+static inline auto
+js_get_typedarray_info(js_env_t *env, js_typedarray_t<uint8_t> &typedarray, T *&data) {
+  int err;
+
+  size_t len;
+  err = js_get_typedarray_info(env, typedarray.value, nullptr, (void **) &data, &len, nullptr, nullptr);
+  if (err < 0) return err;
+
+  assert(len == sizeof(T));
+
+  return 0;
+}
+
+template <typename T>
+static inline auto
+js_get_typedarray_info(js_env_t *env, js_typedarray_t<T> &typedarray, std::span<T> &view) {
+  int err;
+
+  T *data;
+  size_t len;
+  err = js_get_typedarray_info(env, typedarray, data, len);
+  if (err < 0) return err;
+
+  view = std::span(data, len);
+
+  return 0;
+}
+
+template <typename T>
+static inline auto
+js_get_typedarray_info(js_env_t *env, const js_typedarray_t<T> &typedarray, std::span<T> &view, js_arraybuffer_t &arraybuffer, size_t &offset) {
+  int err;
+
+  T *data;
+  size_t len;
+  err = js_get_typedarray_info(env, typedarray.value, nullptr, (void **) &data, &len, &arraybuffer.value, &offset);
+  if (err < 0) return err;
+
+  view = std::span(data, len);
+
+  return 0;
+}
+
+static inline auto
+js_get_typedarray_info(js_env_t *env, const js_typedarray_any_t &typedarray, js_typedarray_type_t &type, std::span<std::byte> &view, js_arraybuffer_t &arraybuffer, size_t &offset) {
+  int err;
+
+  std::byte *data;
+  size_t len;
+  err = js_get_typedarray_info(env, typedarray.value, &type, (void **) &data, &len, &arraybuffer.value, &offset);
+  if (err < 0) return err;
+
+  view = std::span(data, len * js_typedarray_element_size(type));
+
+  return 0;
+}
+
+static inline auto
+js_get_typedarray_info(js_env_t *env, const js_typedarray_any_t &typedarray, js_typedarray_type_t &type, std::span<std::byte> &view) {
+  int err;
+
+  std::byte *data;
+  size_t len;
+  err = js_get_typedarray_info(env, typedarray.value, &type, (void **) &data, &len, nullptr, nullptr);
+  if (err < 0) return err;
+
+  view = std::span(data, len * js_typedarray_element_size(type));
+
+  return 0;
+}
+
+static inline auto
+js_get_arraybuffer_view_info(js_env_t *env, const js_arraybuffer_view_t &view, std::span<std::byte> &data, js_arraybuffer_t &arraybuffer, size_t &offset) {
+  int err;
+
+  bool is_typedarray;
+  err = js_is_typedarray(env, view.value, &is_typedarray);
+  if (err < 0) return err;
+
+  if (is_typedarray) {
+    js_typedarray_type_t type;
+    return js_get_typedarray_info(env, js_typedarray_any_t(view.value), type, data, arraybuffer, offset);
+  }
+
+  return js_get_dataview_info(env, js_dataview_t(view.value), data, arraybuffer, offset);
+}
+
+static inline auto
+js_get_arraybuffer_view_info(js_env_t *env, const js_arraybuffer_view_t &view, std::span<std::byte> &data) {
+  js_arraybuffer_t arraybuffer;
+  size_t offset;
+  return js_get_arraybuffer_view_info(env, view, data, arraybuffer, offset);
+}
+
+static inline auto
+js_get_value_bigint(js_env_t *env, const js_bigint_t &bigint, int64_t &result) {
+  return js_get_value_bigint_int64(env, bigint.value, &result, nullptr);
+}
+
+static inline auto
+js_get_value_bigint(js_env_t *env, const js_bigint_t &bigint, int64_t &result, bool &lossless) {
+  return js_get_value_bigint_int64(env, bigint.value, &result, &lossless);
+}
+
+static inline auto
+js_get_value_bigint(js_env_t *env, const js_bigint_t &bigint, uint64_t &result) {
+  return js_get_value_bigint_uint64(env, bigint.value, &result, nullptr);
+}
+
+static inline auto
+js_get_value_bigint(js_env_t *env, const js_bigint_t &bigint, uint64_t &result, bool &lossless) {
+  return js_get_value_bigint_uint64(env, bigint.value, &result, &lossless);
+}
+
+static inline auto
+js_get_value_bigint(js_env_t *env, const js_bigint_t &bigint, int &sign, std::vector<uint64_t> &words) {
+  int err;
+
+  size_t len;
+  err = js_get_value_bigint_words(env, bigint.value, &sign, nullptr, 0, &len);
+  if (err < 0) return err;
+
+  words.resize(len);
+
+  return js_get_value_bigint_words(env, bigint.value, &sign, words.data(), words.size(), nullptr);
+}
+
+static inline auto
+js_get_value_string(js_env_t *env, const js_string_t &string, std::string &result) {
+  int err;
+
+  size_t len;
+  err = js_get_value_string_utf8(env, string.value, nullptr, 0, &len);
+  if (err < 0) return err;
+
+  result.resize(len);
+
+  return js_get_value_string_utf8(env, string.value, (utf8_t *) result.data(), result.length(), nullptr);
+}
+
+static inline auto
+js_get_global(js_env_t *env, js_object_t &result) {
+  return js_get_global(env, &result.value);
+}
+
+static inline auto
+js_get_property(js_env_t *env, const js_object_t &object, const js_name_t &name, js_handle_t &result) {
+  return js_get_property(env, object.value, name.value, &result.value);
+}
+
+static inline auto
+js_get_property(js_env_t *env, const js_object_t &object, const char *name, js_handle_t &result) {
+  return js_get_named_property(env, object.value, name, &result.value);
+}
+
+template <bool checked = js_is_debug, typename T>
+static inline auto
+js_get_property(js_env_t *env, const js_object_t &object, const js_name_t &name, T &result) {
+  int err;
+
+  js_value_t *value;
+  err = js_get_property(env, object.value, name.value, &value);
+  if (err < 0) return err;
+
+  return js_type_info_t<T>::template unmarshall<checked>(env, value, result);
+}
+
+template <bool checked = js_is_debug, typename T>
+static inline auto
+js_get_property(js_env_t *env, const js_object_t &object, const char *name, T &result) {
+  int err;
+
+  js_value_t *value;
+  err = js_get_named_property(env, object.value, name, &value);
+  if (err < 0) return err;
+
+  return js_type_info_t<T>::template unmarshall<checked>(env, value, result);
+}
+
+static inline auto
+js_set_property(js_env_t *env, const js_object_t &object, const js_name_t &name, const js_handle_t &value) {
+  return js_set_property(env, object.value, name.value, value.value);
+}
+
+static inline auto
+js_set_property(js_env_t *env, const js_object_t &object, const char *name, const js_handle_t &value) {
+  return js_set_named_property(env, object.value, name, value.value);
+}
+
+template <bool checked = js_is_debug, typename T>
+static inline auto
+js_set_property(js_env_t *env, const js_object_t &object, const js_name_t &name, const T &value) {
+  int err;
+
+  js_value_t *marshalled;
+  err = js_type_info_t<T>::template marshall<checked>(env, value, marshalled);
+  if (err < 0) return err;
+
+  return js_set_property(env, object.value, name.value, marshalled);
+}
+
+template <bool checked = js_is_debug, typename T>
+static inline auto
+js_set_property(js_env_t *env, const js_object_t &object, const char *name, const T &value) {
+  int err;
+
+  js_value_t *marshalled;
+  err = js_type_info_t<T>::template marshall<checked>(env, value, marshalled);
+  if (err < 0) return err;
+
+  return js_set_named_property(env, object.value, name, marshalled);
+}
+
+template <auto fn, bool checked = js_is_debug, bool scoped = true>
+static inline auto
+js_set_property(js_env_t *env, const js_object_t &object, const js_name_t &name) {
+  int err;
+
+  js_handle_t value;
+  err = js_function_info_t<fn>::template marshall<checked, scoped>(env, nullptr, 0, value);
+  if (err < 0) return err;
+
+  return js_set_property(env, object, name, value);
+}
+
+template <auto fn, bool checked = js_is_debug, bool scoped = true>
+static inline auto
+js_set_property(js_env_t *env, const js_object_t &object, const char *name) {
+  int err;
+
+  js_handle_t value;
+  err = js_function_info_t<fn>::template marshall<checked, scoped>(env, name, -1, value);
+  if (err < 0) return err;
+
+  return js_set_named_property(env, object, name, value);
+}
+
+static inline auto
+js_get_element(js_env_t *env, const js_object_t &object, uint32_t index, js_handle_t &result) {
+  return js_get_element(env, object.value, index, &result.value);
+}
+
+template <bool checked = js_is_debug, typename T>
+static inline auto
+js_get_element(js_env_t *env, const js_object_t &object, uint32_t index, T &result) {
+  int err;
+
+  js_value_t *value;
+  err = js_get_element(env, object.value, index, &value);
+  if (err < 0) return err;
+
+  return js_type_info_t<T>::template unmarshall<checked>(env, value, result);
+}
+
+static inline auto
+js_set_element(js_env_t *env, const js_object_t &object, uint32_t index, const js_handle_t &value) {
+  return js_set_element(env, object.value, index, value.value);
+}
+
+template <bool checked = js_is_debug, typename T>
+static inline auto
+js_set_element(js_env_t *env, const js_object_t &object, uint32_t index, const T &value) {
+  int err;
+
+  js_value_t *marshalled;
+  err = js_type_info_t<T>::template marshall<checked>(env, value, marshalled);
+  if (err < 0) return err;
+
+  return js_set_element(env, object.value, index, marshalled);
+}
+
+template <auto fn, bool checked = js_is_debug, bool scoped = true>
+static inline auto
+js_set_element(js_env_t *env, const js_object_t &object, uint32_t index) {
+  int err;
+
+  js_handle_t value;
+  err = js_function_info_t<fn>::template marshall<checked, scoped>(env, nullptr, 0, value);
+  if (err < 0) return err;
+
+  return js_set_element(env, object, index, value);
+}
+
+template <bool checked = js_is_debug, typename T, size_t N>
+static inline auto
+js_get_array_elements(js_env_t *env, const js_array_t &array, T result[N]) {
+  int err;
+
+  js_value_t *values[N];
+  uint32_t len;
+  err = js_get_array_elements(env, array.value, values, N, 0, &len);
+  if (err < 0) return err;
+
+  assert(len == N);
+
+  for (uint32_t i = 0; i < N; i++) {
+    err = js_type_info_t<T>::template unmarshall<checked>(env, values[i], result[i]);
+    if (err < 0) return err;
+  }
+
+  return 0;
+}
+
+template <bool checked = js_is_debug, typename T, size_t N>
+static inline auto
+js_get_array_elements(js_env_t *env, const js_array_t &array, std::array<T, N> &result) {
+  int err;
+
+  js_value_t *values[N];
+  uint32_t len;
+  err = js_get_array_elements(env, array.value, values, N, 0, &len);
+  if (err < 0) return err;
+
+  assert(len == N);
+
+  for (uint32_t i = 0; i < N; i++) {
+    err = js_type_info_t<T>::template unmarshall<checked>(env, values[i], result[i]);
+    if (err < 0) return err;
+  }
+
+  return 0;
+}
+
+template <bool checked = js_is_debug, typename T>
+static inline auto
+js_get_array_elements(js_env_t *env, const js_array_t &array, std::vector<T> &result) {
+  int err;
+
+  uint32_t len;
+  err = js_get_array_length(env, array.value, &len);
+  if (err < 0) return err;
+
+  std::vector<js_value_t *> values(len);
+  err = js_get_array_elements(env, array.value, values.data(), len, 0, &len);
+  if (err < 0) return err;
+
+  result.resize(len);
+
+  for (uint32_t i = 0; i < len; i++) {
+    err = js_type_info_t<T>::template unmarshall<checked>(env, values[i], result[i]);
+    if (err < 0) return err;
+  }
+
+  return 0;
+}
+
+template <bool checked = js_is_debug, typename T, size_t N>
+static inline auto
+js_set_array_elements(js_env_t *env, const js_array_t &array, const T values[N], size_t offset = 0) {
+  int err;
+
+  js_value_t *marshalled[N];
+
+  for (uint32_t i = 0; i < N; i++) {
+    err = js_type_info_t<T>::template marshall<checked>(env, values[i], marshalled[i]);
+    if (err < 0) return err;
+  }
+
+  return js_set_array_elements(env, array.value, (const js_value_t **) marshalled, N, offset);
+}
+
+template <bool checked = js_is_debug, typename T, size_t N>
+static inline auto
+js_set_array_elements(js_env_t *env, const js_array_t &array, const std::array<T, N> &values, size_t offset = 0) {
+  int err;
+
+  js_value_t *marshalled[N];
+
+  for (uint32_t i = 0; i < N; i++) {
+    err = js_type_info_t<T>::template marshall<checked>(env, values[i], marshalled[i]);
+    if (err < 0) return err;
+  }
+
+  return js_set_array_elements(env, array.value, (const js_value_t **) marshalled, N, offset);
+}
+
+template <bool checked = js_is_debug, typename T>
+static inline auto
+js_set_array_elements(js_env_t *env, const js_array_t &array, const std::vector<T> &values, size_t offset = 0) {
+  int err;
+
+  auto len = values.size();
+
+  std::vector<js_value_t *> marshalled(len);
+
+  for (uint32_t i = 0; i < len; i++) {
+    err = js_type_info_t<T>::template marshall<checked>(env, values[i], marshalled[i]);
+    if (err < 0) return err;
+  }
+
+  return js_set_array_elements(env, array.value, (const js_value_t **) marshalled.data(), len, offset);
+}
+
+template <bool checked = js_is_debug, typename T>
+static inline auto
+js_create_property_descriptor(js_env_t *env, const js_property_t<T> &property, js_property_descriptor_t &result) {
+  int err;
+
+  js_property_descriptor_t descriptor;
+
+  descriptor.version = 0;
+  descriptor.data = nullptr;
+  descriptor.attributes = property.attributes;
+  descriptor.method = nullptr;
+  descriptor.getter = nullptr;
+  descriptor.setter = nullptr;
+
+  if (property.key.value == nullptr) {
+    const auto &name = property.name;
+
+    err = js_create_string_utf8(env, (const utf8_t *) name.data(), name.length(), &descriptor.name);
+    if (err < 0) return err;
+  } else {
+    descriptor.name = property.key.value;
+  }
+
+  err = js_type_info_t<T>::template marshall<checked>(env, property.value, descriptor.value);
+  if (err < 0) return err;
+
+  result = descriptor;
+
+  return 0;
+}
+
+template <bool checked = js_is_debug, bool scoped = true, auto getter, auto setter>
+static inline auto
+js_create_property_descriptor(js_env_t *env, const js_property_t<js_accessor_t<getter, setter>> &property, js_property_descriptor_t &result) {
+  int err;
+
+  js_property_descriptor_t descriptor;
+
+  descriptor.version = 0;
+  descriptor.data = nullptr;
+  descriptor.attributes = property.attributes & ~js_writable;
+  descriptor.method = nullptr;
+  descriptor.getter = js_untyped_callback<getter, checked, scoped>();
+  descriptor.value = nullptr;
+
+  if constexpr (std::is_null_pointer<decltype(setter)>()) {
+    descriptor.setter = nullptr;
+  } else {
+    descriptor.setter = js_untyped_callback<setter, checked, scoped>();
+  }
+
+  if (property.key.value == nullptr) {
+    const auto &name = property.name;
+
+    err = js_create_string_utf8(env, (const utf8_t *) name.data(), name.length(), &descriptor.name);
+    if (err < 0) return err;
+  } else {
+    descriptor.name = property.key.value;
+  }
+
+  result = descriptor;
+
+  return 0;
+}
+
+template <bool checked = js_is_debug, typename T>
+static inline auto
+js_create_property_descriptor(js_env_t *env, const js_property_t<T> &property) {
+  int err;
+
+  js_property_descriptor_t descriptor;
+  err = js_create_property_descriptor<checked>(env, property, descriptor);
+  assert(err == 0);
+
+  return descriptor;
+}
+
+template <bool checked = js_is_debug, typename... T>
+static inline auto
+js_define_properties(js_env_t *env, const js_object_t &object, const js_property_t<T>... properties) {
+  js_property_descriptor_t descriptors[] = {
+    js_create_property_descriptor<checked>(env, properties)...
+  };
+
+  return js_define_properties(env, object.value, descriptors, sizeof...(T));
+}
+
+template <js_string_literal_t name, auto fn>
+struct js_export_method_t {
+  static int
+  redefine(js_env_t *env, js_value_t *object, js_value_t *value) {
+    int err;
+
+    js_property_descriptor_t descriptor;
+
+    descriptor.version = 0;
+    descriptor.data = nullptr;
+    descriptor.attributes = js_writable | js_enumerable | js_configurable;
+    descriptor.method = nullptr;
+    descriptor.getter = nullptr;
+    descriptor.setter = nullptr;
+    descriptor.value = value;
+
+    err = js_create_string_utf8(env, (const utf8_t *) name.value, name.length, &descriptor.name);
+    if (err < 0) return err;
+
+    return js_define_properties(env, object, &descriptor, 1);
+  }
+
+  template <bool checked, bool scoped>
+  static js_value_t *
+  materialize(js_env_t *env, js_callback_info_t *info) {
+    int err;
+
+    js_escapable_handle_scope_t *scope;
+
+    if constexpr (scoped) {
+      err = js_open_escapable_handle_scope(env, &scope);
+      assert(err == 0);
+    }
+
+    js_value_t *result = nullptr;
 
-      js_handle_scope_t *scope;
+    js_value_t *receiver;
+    void *data;
+    err = js_get_callback_info(env, info, nullptr, nullptr, &receiver, &data);
+    assert(err == 0);
 
-      if constexpr (scoped) {
-        err = js_open_handle_scope(env, &scope);
-        assert(err == 0);
-      }
+    js_value_t *holder = nullptr;
+    err = js_get_reference_value(env, static_cast<js_ref_t *>(data), &holder);
+    assert(err == 0);
 
-      size_t argc = sizeof...(A);
-      js_value_t *argv[sizeof...(A)];
+    if (holder == nullptr) holder = receiver;
 
-      if constexpr (js_argument_info_t<A...>::has_receiver) {
-        argc--;
+    js_handle_t function;
+    err = js_function_info_t<fn>::template marshall<checked, scoped>(env, name.value, name.length, function);
 
-        err = js_get_callback_info(env, info, &argc, &argv[1], &argv[0], nullptr);
-        assert(err == 0);
+    if (err == 0) err = redefine(env, holder, function);
 
-        argc++;
-      } else {
-        err = js_get_callback_info(env, info, &argc, argv, nullptr, nullptr);
+    if (err == 0) result = function;
+
+    if constexpr (scoped) {
+      if (result != nullptr) {
+        err = js_escape_handle(env, scope, result, &result);
         assert(err == 0);
       }
 
-      assert(argc == sizeof...(A));
+      err = js_close_escapable_handle_scope(env, scope);
+      assert(err == 0);
+    }
 
-      js_value_t *result;
+    return result;
+  }
 
-      try {
-        result = js_marshall_untyped_value<checked, R>(env, fn(js_unmarshall_untyped_value<checked, A>(env, argv[I])...));
-      } catch (int err) {
-        assert(err != 0);
-      }
+  static js_value_t *
+  replace(js_env_t *env, js_callback_info_t *info) {
+    int err;
 
-      if constexpr (scoped) {
-        err = js_close_handle_scope(env, scope);
-        assert(err == 0);
-      }
+    size_t argc = 1;
+    js_value_t *argv[1];
+    js_value_t *receiver;
+    err = js_get_callback_info(env, info, &argc, argv, &receiver, nullptr);
+    assert(err == 0);
 
-      return result;
-    };
+    redefine(env, receiver, argv[0]);
+
+    return nullptr;
   }
 
-  template <bool checked, bool scoped>
-  static inline auto
-  create() {
-    return create<checked, scoped>(std::index_sequence_for<A...>());
+  template <bool checked, bool scoped, bool lazy>
+  static auto
+  create_descriptor(js_env_t *env, js_ref_t *holder, js_property_descriptor_t &result) {
+    result.version = 0;
+    result.value = nullptr;
+
+    if constexpr (lazy) {
+      result.data = (void *) holder;
+      result.attributes = js_enumerable | js_configurable;
+      result.method = nullptr;
+      result.getter = materialize<checked, scoped>;
+      result.setter = replace;
+    } else {
+      result.data = nullptr;
+      result.attributes = js_writable | js_enumerable | js_configurable;
+      result.method = js_untyped_callback<fn, checked, scoped>();
+      result.getter = nullptr;
+      result.setter = nullptr;
+    }
+
+    return js_create_string_utf8(env, (const utf8_t *) name.value, name.length, &result.name);
   }
 };
 
-template <typename R, typename... A, R fn(js_env_t *, A...)>
-struct js_untyped_callback_t<fn> {
-  template <bool checked, bool scoped, size_t... I>
-  static inline auto
-  create(std::index_sequence<I...>) {
-    return +[](js_env_t *env, js_callback_info_t *info) -> js_value_t * {
-      int err;
+template <js_string_literal_t name, auto value>
+struct js_export_value_t {
+  template <bool checked, bool scoped, bool lazy>
+  static auto
+  create_descriptor(js_env_t *env, js_ref_t *, js_property_descriptor_t &result) {
+    int err;
 
-      js_escapable_handle_scope_t *scope;
+    result.version = 0;
+    result.data = nullptr;
+    result.attributes = js_enumerable;
+    result.method = nullptr;
+    result.getter = nullptr;
+    result.setter = nullptr;
 
-      if constexpr (scoped) {
-        err = js_open_escapable_handle_scope(env, &scope);
-        assert(err == 0);
-      }
+    err = js_type_info_t<std::remove_cv_t<decltype(value)>>::template marshall<checked>(env, value, result.value);
+    if (err < 0) return err;
 
-      size_t argc = sizeof...(A);
-      js_value_t *argv[sizeof...(A)];
+    return js_create_string_utf8(env, (const utf8_t *) name.value, name.length, &result.name);
+  }
+};
 
-      if constexpr (js_argument_info_t<A...>::has_receiver) {
-        argc--;
+template <typename... E>
+struct js_exports_t {
+  template <bool checked, bool scoped, bool lazy>
+  static auto
+  define(js_env_t *env, js_value_t *exports) {
+    int err;
 
-        err = js_get_callback_info(env, info, &argc, &argv[1], &argv[0], nullptr);
-        assert(err == 0);
+    js_ref_t *holder = nullptr;
 
-        argc++;
-      } else {
-        err = js_get_callback_info(env, info, &argc, argv, nullptr, nullptr);
-        assert(err == 0);
-      }
+    if constexpr (lazy) {
+      err = js_create_reference(env, exports, 0, &holder);
+      if (err < 0) return err;
 
-      assert(argc == sizeof...(A));
+      auto finalize = +[](js_env_t *env, void *data, void *) {
+        int err;
+        err = js_delete_reference(env, static_cast<js_ref_t *>(data));
+        assert(err == 0);
+      };
 
-      js_value_t *result;
+      err = js_add_finalizer(env, exports, (void *) holder, finalize, nullptr, nullptr);
 
-      try {
-        result = js_marshall_untyped_value<checked, R>(env, fn(env, js_unmarshall_untyped_value<checked, A>(env, argv[I])...));
+      if (err < 0) {
+        js_delete_reference(env, holder);
 
-        if constexpr (scoped) {
-          err = js_escape_handle(env, scope, result, &result);
-          assert(err == 0);
-        }
-      } catch (int err) {
-        assert(err != 0);
+        return err;
       }
+    }
 
-      if constexpr (scoped) {
-        err = js_close_escapable_handle_scope(env, scope);
-        assert(err == 0);
-      }
+    std::array<js_property_descriptor_t, sizeof...(E)> descriptors;
 
-      return result;
-    };
-  }
+    size_t i = 0;
 
-  template <bool checked, bool scoped>
-  static inline auto
-  create() {
-    return create<checked, scoped>(std::index_sequence_for<A...>());
+    if (!(((err = E::template create_descriptor<checked, scoped, lazy>(env, holder, descriptors[i++])) == 0) && ...)) return err;
+
+    return js_define_properties(env, exports, descriptors.data(), descriptors.size());
   }
 };
 
-template <typename... A, void fn(A...)>
-struct js_untyped_callback_t<fn> {
-  template <bool checked, bool scoped, size_t... I>
-  static inline auto
-  create(std::index_sequence<I...>) {
-    return +[](js_env_t *env, js_callback_info_t *info) -> js_value_t * {
-      int err;
-
-      js_handle_scope_t *scope;
+template <typename E, bool checked = js_is_debug, bool scoped = true, bool lazy = false>
+static inline auto
+js_define_exports(js_env_t *env, const js_object_t &exports) {
+  return E::template define<checked, scoped, lazy>(env, exports.value);
+}
 
-      if constexpr (scoped) {
-        err = js_open_handle_scope(env, &scope);
-        assert(err == 0);
-      }
+template <typename E, bool checked = js_is_debug, bool scoped = true>
+static inline auto
+js_define_lazy_exports(js_env_t *env, const js_object_t &exports) {
+  return E::template define<checked, scoped, true>(env, exports.value);
+}
 
-      size_t argc = sizeof...(A);
-      js_value_t *argv[sizeof...(A)];
+template <typename T>
+static inline auto
+js_unwrap(js_env_t *env, const js_object_t &object, T *&result) {
+  return js_unwrap(env, object.value, (void **) &result);
+}
 
-      if constexpr (js_argument_info_t<A...>::has_receiver) {
-        argc--;
+template <typename T>
+struct js_class_tag_t {
+  static inline const char anchor = 0;
 
-        err = js_get_callback_info(env, info, &argc, &argv[1], &argv[0], nullptr);
-        assert(err == 0);
+  static inline const js_type_tag_t tag = {uint64_t(uintptr_t(&anchor)), 0x6a735f636c617373};
+};
 
-        argc++;
-      } else {
-        err = js_get_callback_info(env, info, &argc, argv, nullptr, nullptr);
-        assert(err == 0);
-      }
+template <typename T>
+static inline int
+js_unwrap_instance(js_env_t *env, js_value_t *receiver, T *&result) {
+  int err;
 
-      assert(argc == sizeof...(A));
+  bool is_instance;
+  err = js_is_object(env, receiver, &is_instance);
+  if (err < 0) return err;
 
-      try {
-        fn(js_unmarshall_untyped_value<checked, A>(env, argv[I])...);
-      } catch (int err) {
-        assert(err != 0);
-      }
+  if (is_instance) {
+    err = js_check_type_tag(env, receiver, &js_class_tag_t<T>::tag, &is_instance);
+    if (err < 0) return err;
+  }
 
-      if constexpr (scoped) {
-        err = js_close_handle_scope(env, scope);
-        assert(err == 0);
-      }
+  if (!is_instance) {
+    err = js_throw_type_error(env, nullptr, "Receiver is not an instance of the class");
+    assert(err == 0);
 
-      return js_marshall_untyped_value<checked>(env);
-    };
+    return js_pending_exception;
   }
 
-  template <bool checked, bool scoped>
-  static inline auto
-  create() {
-    return create<checked, scoped>(std::index_sequence_for<A...>());
-  }
-};
+  return js_unwrap(env, receiver, (void **) &result);
+}
 
-template <typename... A, void fn(js_env_t *, A...)>
-struct js_untyped_callback_t<fn> {
+template <typename F, typename T, typename R, typename... A>
+struct js_member_callback_t {
   template <bool checked, bool scoped, size_t... I>
   static inline auto
   create(std::index_sequence<I...>) {
     return +[](js_env_t *env, js_callback_info_t *info) -> js_value_t * {
       int err;
 
-      js_handle_scope_t *scope;
+      js_escapable_handle_scope_t *scope;
 
       if constexpr (scoped) {
-        err = js_open_handle_scope(env, &scope);
+        err = js_open_escapable_handle_scope(env, &scope);
         assert(err == 0);
       }
 
       size_t argc = sizeof...(A);
       js_value_t *argv[sizeof...(A)];
+      js_value_t *receiver;
 
-      if constexpr (js_argument_info_t<A...>::has_receiver) {
-        argc--;
-
-        err = js_get_callback_info(env, info, &argc, &argv[1], &argv[0], nullptr);
-        assert(err == 0);
-
-        argc++;
-      } else {
-        err = js_get_callback_info(env, info, &argc, argv, nullptr, nullptr);
-        assert(err == 0);
-      }
+      err = js_get_callback_info(env, info, &argc, argv, &receiver, nullptr);
+      assert(err == 0);
 
       assert(argc == sizeof...(A));
 
+      js_value_t *result = nullptr;
+
       try {
-        fn(env, js_unmarshall_untyped_value<checked, A>(env, argv[I])...);
+        auto args = js_unmarshall_arguments<checked, 1, A...>(env, argv, std::index_sequence<I...>());
+
+        T *self;
+        err = js_unwrap_instance(env, receiver, self);
+        if (err < 0) throw err;
+
+        if constexpr (std::is_void<R>()) {
+          F::call(env, self, std::get<I>(std::move(args))...);
+
+          result = js_marshall_untyped_value<checked>(env);
+        } else {
+          result = js_marshall_untyped_value<checked, R>(env, F::call(env, self, std::get<I>(std::move(args))...));
+        }
+
+        if constexpr (scoped) {
+          err = js_escape_handle(env, scope, result, &result);
+          assert(err == 0);
+        }
       } catch (int err) {
         assert(err != 0);
       }
 
       if constexpr (scoped) {
-        err = js_close_handle_scope(env, scope);
+        err = js_close_escapable_handle_scope(env, scope);
         assert(err == 0);
       }
 
-      return js_marshall_untyped_value<checked>(env);
+      return result;
     };
   }
 
@@ -1627,568 +5317,470 @@ struct js_untyped_callback_t<fn> {
   }
 };
 
-template <auto fn, bool checked = js_is_debug, bool scoped = true>
-static inline auto
-js_typed_callback() {
-  return js_typed_callback_t<fn>::template create<checked, scoped>();
-}
-
-template <auto fn, bool checked = js_is_debug, bool scoped = true>
-static inline auto
-js_untyped_callback() {
-  return js_untyped_callback_t<fn>::template create<checked, scoped>();
-}
-
 template <auto fn>
-struct js_function_info_t;
+struct js_member_function_info_t;
 
-template <typename R, typename... A, R fn(A...)>
-struct js_function_info_t<fn> {
-  using type = R(A...);
+template <typename T, typename R, typename... A, R (T::*fn)(A...)>
+struct js_member_function_info_t<fn> {
+  using type = T;
   using result = R;
   using arguments = std::tuple<A...>;
 
-  template <bool checked, bool scoped>
-  static auto
-  marshall(js_env_t *env, const char *name, size_t len, js_function_t<R, A...> &result) {
-    auto typed = js_typed_callback<fn, checked, scoped>();
-
-    auto untyped = js_untyped_callback<fn, checked, scoped>();
-
-    js_callback_signature_t signature;
-
-    int args[] = {
-      js_type_info_t<A>::signature...
-    };
-
-    signature.version = 0;
-    signature.result = js_type_info_t<R>::signature;
-    signature.args_len = sizeof...(A);
-    signature.args = args;
-
-    return js_create_typed_function(env, name, len, untyped, &signature, (const void *) typed, nullptr, &result.value);
+  static inline R
+  call(js_env_t *, T *self, A... args) {
+    return (self->*fn)(std::forward<A>(args)...);
   }
 
-  template <bool checked, bool scoped>
-  static auto
-  marshall(js_env_t *env, const char *name, size_t len, js_handle_t &result) {
-    int err;
-
-    js_function_t<R, A...> value;
-    err = marshall<checked, scoped>(env, name, len, value);
-    if (err < 0) return err;
-
-    result = value;
-
-    return 0;
+  template <typename W, bool checked, bool scoped>
+  static inline auto
+  create() {
+    return js_member_callback_t<js_member_function_info_t, W, R, A...>::template create<checked, scoped>();
   }
 };
 
-template <typename R, typename... A, R fn(js_env_t *, A...)>
-struct js_function_info_t<fn> {
-  using type = R(js_env_t *, A...);
-  using result = R;
-  using arguments = std::tuple<A...>;
-
-  template <bool checked, bool scoped>
-  static auto
-  marshall(js_env_t *env, const char *name, size_t len, js_function_t<R, A...> &result) {
-    auto typed = js_typed_callback<fn, checked, scoped>();
-
-    auto untyped = js_untyped_callback<fn, checked, scoped>();
-
-    js_callback_signature_t signature;
-
-    int args[] = {
-      js_type_info_t<A>::signature...
-    };
-
-    signature.version = 0;
-    signature.result = js_type_info_t<R>::signature;
-    signature.args_len = sizeof...(A);
-    signature.args = args;
-
-    return js_create_typed_function(env, name, len, untyped, &signature, (const void *) typed, nullptr, &result.value);
-  }
-
-  template <bool checked, bool scoped>
-  static auto
-  marshall(js_env_t *env, const char *name, size_t len, js_handle_t &result) {
-    int err;
-
-    js_function_t<R, A...> value;
-    err = marshall<checked, scoped>(env, name, len, value);
-    if (err < 0) return err;
-
-    result = value;
+template <typename T, typename R, typename... A, R (T::*fn)(A...) const>
+struct js_member_function_info_t<fn> {
+  using type = T;
+  using result = R;
+  using arguments = std::tuple<A...>;
 
-    return 0;
+  static inline R
+  call(js_env_t *, T *self, A... args) {
+    return (self->*fn)(std::forward<A>(args)...);
+  }
+
+  template <typename W, bool checked, bool scoped>
+  static inline auto
+  create() {
+    return js_member_callback_t<js_member_function_info_t, W, R, A...>::template create<checked, scoped>();
   }
 };
 
-template <auto fn, bool checked = js_is_debug, bool scoped = true, typename R, typename... A>
-static inline auto
-js_create_function(js_env_t *env, const char *name, size_t len, js_function_t<R, A...> &result) {
-  return js_function_info_t<fn>::template marshall<checked, scoped>(env, name, len, result);
-}
+template <typename T, typename R, typename... A, R (T::*fn)(js_env_t *, A...)>
+struct js_member_function_info_t<fn> {
+  using type = T;
+  using result = R;
+  using arguments = std::tuple<A...>;
 
-template <auto fn, bool checked = js_is_debug, bool scoped = true, typename R, typename... A>
-static inline auto
-js_create_function(js_env_t *env, const std::string &name, js_function_t<R, A...> &result) {
-  return js_function_info_t<fn>::template marshall<checked, scoped>(env, name.data(), name.size(), result);
-}
+  static inline R
+  call(js_env_t *env, T *self, A... args) {
+    return (self->*fn)(env, std::forward<A>(args)...);
+  }
 
-template <auto fn, bool checked = js_is_debug, bool scoped = true, typename R, typename... A>
-static inline auto
-js_create_function(js_env_t *env, js_function_t<R, A...> &result) {
-  return js_function_info_t<fn>::template marshall<checked, scoped>(env, nullptr, 0, result);
-}
+  template <typename W, bool checked, bool scoped>
+  static inline auto
+  create() {
+    return js_member_callback_t<js_member_function_info_t, W, R, A...>::template create<checked, scoped>();
+  }
+};
 
-template <auto fn, bool checked = js_is_debug, bool scoped = true>
-static inline auto
-js_create_function(js_env_t *env, const char *name, size_t len, js_handle_t &result) {
-  return js_function_info_t<fn>::template marshall<checked, scoped>(env, name, len, result);
-}
+template <typename T, typename R, typename... A, R (T::*fn)(js_env_t *, A...) const>
+struct js_member_function_info_t<fn> {
+  using type = T;
+  using result = R;
+  using arguments = std::tuple<A...>;
 
-template <auto fn, bool checked = js_is_debug, bool scoped = true>
-static inline auto
-js_create_function(js_env_t *env, std::string name, js_handle_t &result) {
-  return js_function_info_t<fn>::template marshall<checked, scoped>(env, name.data(), name.length(), result);
-}
+  static inline R
+  call(js_env_t *env, T *self, A... args) {
+    return (self->*fn)(env, std::forward<A>(args)...);
+  }
 
-template <auto fn, bool checked = js_is_debug, bool scoped = true>
-static inline auto
-js_create_function(js_env_t *env, js_handle_t &result) {
-  return js_function_info_t<fn>::template marshall<checked, scoped>(env, nullptr, 0, result);
-}
+  template <typename W, bool checked, bool scoped>
+  static inline auto
+  create() {
+    return js_member_callback_t<js_member_function_info_t, W, R, A...>::template create<checked, scoped>();
+  }
+};
 
-template <bool checked = js_is_debug, typename... A>
-static inline auto
-js_call_function(js_env_t *env, const js_function_t<void, A...> &function, const A &...args) {
+static inline int
+js_check_new_target(js_env_t *env, js_callback_info_t *info) {
   int err;
 
-  size_t argc = sizeof...(A);
-
-  try {
-    js_value_t *argv[] = {
-      js_marshall_untyped_value<checked, A>(env, args...)...
-    };
+  js_value_t *new_target;
+  err = js_get_new_target(env, info, &new_target);
+  if (err < 0) return err;
 
-    js_value_t *receiver;
+  bool is_undefined = new_target == nullptr;
 
-    size_t offset = 0;
+  if (!is_undefined) {
+    err = js_is_undefined(env, new_target, &is_undefined);
+    if (err < 0) return err;
+  }
 
-    if constexpr (js_argument_info_t<A...>::has_receiver) {
-      receiver = argv[0];
-      offset = 1;
-    } else {
-      err = js_get_global(env, &receiver);
-      assert(err == 0);
-    }
+  if (is_undefined) {
+    err = js_throw_type_error(env, nullptr, "Class constructor cannot be invoked without 'new'");
+    assert(err == 0);
 
-    return js_call_function(env, receiver, function.value, argc - offset, &argv[offset], nullptr);
-  } catch (int err) {
-    return err;
+    return js_pending_exception;
   }
+
+  return 0;
 }
 
-template <bool checked = js_is_debug, typename R, typename... A>
-static inline auto
-js_call_function(js_env_t *env, const js_function_t<R, A...> &function, const A &...args, R &result) {
-  int err;
+template <typename F, typename T, typename... A>
+struct js_constructor_callback_t {
+  static void
+  finalize(js_env_t *, void *data, void *) {
+    delete static_cast<T *>(data);
+  }
 
-  size_t argc = sizeof...(A);
+  template <bool checked, bool scoped, size_t... I>
+  static inline auto
+  create(std::index_sequence<I...>) {
+    return +[](js_env_t *env, js_callback_info_t *info) -> js_value_t * {
+      int err;
 
-  try {
-    js_value_t *argv[] = {
-      js_marshall_untyped_value<checked, A>(env, args...)...
-    };
+      js_handle_scope_t *scope;
 
-    js_value_t *receiver;
+      if constexpr (scoped) {
+        err = js_open_handle_scope(env, &scope);
+        assert(err == 0);
+      }
 
-    size_t offset = 0;
+      size_t argc = sizeof...(A);
+      js_value_t *argv[sizeof...(A)];
+      js_value_t *receiver;
 
-    if constexpr (js_argument_info_t<A...>::has_receiver) {
-      receiver = argv[0];
-      offset = 1;
-    } else {
-      err = js_get_global(env, &receiver);
+      err = js_get_callback_info(env, info, &argc, argv, &receiver, nullptr);
       assert(err == 0);
-    }
 
-    js_value_t *value;
-    err = js_call_function(env, receiver, function.value, argc - offset, &argv[offset], &value);
-    if (err < 0) return err;
+      assert(argc == sizeof...(A));
 
-    result = js_unmarshall_untyped_value<checked, R>(env, value);
+      js_value_t *result = nullptr;
 
-    return 0;
-  } catch (int err) {
-    return err;
-  }
-}
+      try {
+        err = js_check_new_target(env, info);
+        if (err < 0) throw err;
 
-static inline auto
-js_create_object(js_env_t *env, js_object_t &result) {
-  return js_create_object(env, &result.value);
-}
+        auto args = js_unmarshall_arguments<checked, 1, A...>(env, argv, std::index_sequence<I...>());
 
-template <typename... T>
-static inline auto
-js_create_object(js_env_t *env, js_object_t &result, const js_property_t<T>... properties) {
-  int err;
-  err = js_create_object(env, result);
-  if (err < 0) return err;
+        T *self;
 
-  return js_define_properties(env, result, properties...);
-}
+        if constexpr (std::is_same<typename F::result, T *>()) {
+          self = F::call(env, std::get<I>(std::move(args))...);
+        } else {
+          self = new T(F::call(env, std::get<I>(std::move(args))...));
+        }
 
-static inline auto
-js_create_array(js_env_t *env, js_array_t &result) {
-  return js_create_array(env, &result.value);
-}
+        err = js_wrap(env, receiver, (void *) self, finalize, nullptr, nullptr);
 
-static inline auto
-js_create_array(js_env_t *env, size_t len, js_array_t &result) {
-  return js_create_array_with_length(env, len, &result.value);
-}
+        if (err < 0) {
+          delete self;
 
-template <typename T, size_t N>
-static inline auto
-js_create_array(js_env_t *env, const T values[N], js_array_t &result) {
-  int err;
-  err = js_create_array(env, N, result);
-  if (err < 0) return err;
+          throw err;
+        }
 
-  return js_set_array_elements(env, result, values);
-}
+        err = js_add_type_tag(env, receiver, &js_class_tag_t<T>::tag);
+        if (err < 0) throw err;
 
-template <typename T, size_t N>
-static inline auto
-js_create_array(js_env_t *env, const std::array<T, N> values, js_array_t &result) {
-  int err;
-  err = js_create_array(env, N, result);
-  if (err < 0) return err;
+        result = receiver;
+      } catch (int err) {
+        assert(err != 0);
+      }
 
-  return js_set_array_elements(env, result, values);
-}
+      if constexpr (scoped) {
+        err = js_close_handle_scope(env, scope);
+        assert(err == 0);
+      }
 
-template <typename T>
-static inline auto
-js_create_array(js_env_t *env, const std::vector<T> values, js_array_t &result) {
-  int err;
-  err = js_create_array(env, values.size(), result);
-  if (err < 0) return err;
+      return result;
+    };
+  }
 
-  return js_set_array_elements(env, result, values);
-}
+  template <bool checked, bool scoped>
+  static inline auto
+  create() {
+    return create<checked, scoped>(std::index_sequence_for<A...>());
+  }
+};
 
-static inline auto
-js_create_bigint(js_env_t *env, int64_t value, js_bigint_t &result) {
-  return js_create_bigint_int64(env, value, &result.value);
-}
+template <auto fn>
+struct js_constructor_info_t;
 
-static inline auto
-js_create_bigint(js_env_t *env, uint64_t value, js_bigint_t &result) {
-  return js_create_bigint_uint64(env, value, &result.value);
-}
+template <typename R, typename... A, R fn(A...)>
+struct js_constructor_info_t<fn> {
+  using result = R;
 
-template <size_t N>
-static inline auto
-js_create_string(js_env_t *env, const char value[N], js_string_t &result) {
-  return js_create_string_utf8(env, value, N, &result.value);
-}
+  static inline R
+  call(js_env_t *, A... args) {
+    return fn(std::forward<A>(args)...);
+  }
 
-static inline auto
-js_create_string(js_env_t *env, const utf8_t *value, size_t len, js_string_t &result) {
-  return js_create_string_utf8(env, value, len, &result.value);
-}
+  template <typename T, bool checked, bool scoped>
+  static inline auto
+  create() {
+    return js_constructor_callback_t<js_constructor_info_t, T, A...>::template create<checked, scoped>();
+  }
+};
 
-static inline auto
-js_create_string(js_env_t *env, const std::string &value, js_string_t &result) {
-  return js_create_string_utf8(env, (const utf8_t *) value.data(), value.length(), &result.value);
-}
+template <typename R, typename... A, R fn(js_env_t *, A...)>
+struct js_constructor_info_t<fn> {
+  using result = R;
 
-template <typename T>
-static inline auto
-js_create_arraybuffer(js_env_t *env, size_t len, T *&data, js_arraybuffer_t &result) {
-  return js_create_arraybuffer(env, len * sizeof(T), (void **) &data, &result.value);
-}
+  static inline R
+  call(js_env_t *env, A... args) {
+    return fn(env, std::forward<A>(args)...);
+  }
 
-template <typename T>
-static inline auto
-js_create_arraybuffer(js_env_t *env, T *&data, js_arraybuffer_t &result) {
-  return js_create_arraybuffer(env, sizeof(T), (void **) &data, &result.value);
-}
+  template <typename T, bool checked, bool scoped>
+  static inline auto
+  create() {
+    return js_constructor_callback_t<js_constructor_info_t, T, A...>::template create<checked, scoped>();
+  }
+};
 
-static inline auto
-js_create_arraybuffer(js_env_t *env, size_t len, js_arraybuffer_t &result) {
-  return js_create_arraybuffer(env, len, nullptr, &result.value);
-}
+template <auto fn>
+struct js_class_method_t {
+  std::string name;
 
-template <typename T>
-static inline auto
-js_create_arraybuffer(js_env_t *env, size_t len, js_arraybuffer_t &result) {
-  return js_create_arraybuffer(env, len * sizeof(T), nullptr, &result.value);
-}
+  js_class_method_t(const std::string &name) : name(name) {}
 
-template <typename T>
-static inline auto
-js_create_arraybuffer(js_env_t *env, size_t len, std::span<T> &view, js_arraybuffer_t &result) {
-  int err;
+  js_class_method_t(const char *name) : name(name) {}
 
-  T *data;
-  err = js_create_arraybuffer(env, len, data, result);
-  if (err < 0) return err;
+  template <typename T, bool checked, bool scoped>
+  auto
+  create_descriptor(js_env_t *env, js_property_descriptor_t &result) const {
+    static_assert(std::is_base_of<typename js_member_function_info_t<fn>::type, T>());
 
-  view = std::span(data, len);
+    result.version = 0;
+    result.data = nullptr;
+    result.attributes = js_writable | js_configurable;
+    result.method = js_member_function_info_t<fn>::template create<T, checked, scoped>();
+    result.getter = nullptr;
+    result.setter = nullptr;
+    result.value = nullptr;
 
-  return 0;
-}
+    return js_create_string_utf8(env, (const utf8_t *) name.data(), name.length(), &result.name);
+  }
+};
 
-template <typename T, size_t N>
-static inline auto
-js_create_arraybuffer(js_env_t *env, const T data[N], js_arraybuffer_t &result) {
-  int err;
+template <auto getter, auto setter = nullptr>
+struct js_class_accessor_t {
+  std::string name;
 
-  std::span<T> view;
-  err = js_create_arraybuffer(env, N, view, result);
-  if (err < 0) return err;
+  js_class_accessor_t(const std::string &name) : name(name) {}
 
-  std::copy(data, data + N, view.begin());
+  js_class_accessor_t(const char *name) : name(name) {}
 
-  return 0;
-}
+  template <typename T, bool checked, bool scoped>
+  auto
+  create_descriptor(js_env_t *env, js_property_descriptor_t &result) const {
+    static_assert(std::is_base_of<typename js_member_function_info_t<getter>::type, T>());
 
-template <typename T, size_t N>
-static inline auto
-js_create_arraybuffer(js_env_t *env, const std::array<T, N> data, js_arraybuffer_t &result) {
-  int err;
+    result.version = 0;
+    result.data = nullptr;
+    result.attributes = js_configurable;
+    result.method = nullptr;
+    result.getter = js_member_function_info_t<getter>::template create<T, checked, scoped>();
+    result.value = nullptr;
 
-  std::span<T> view;
-  err = js_create_arraybuffer(env, N, view, result);
-  if (err < 0) return err;
+    if constexpr (std::is_null_pointer<decltype(setter)>()) {
+      result.setter = nullptr;
+    } else {
+      static_assert(std::is_base_of<typename js_member_function_info_t<setter>::type, T>());
 
-  std::copy(data.begin(), data.end(), view.begin());
+      result.setter = js_member_function_info_t<setter>::template create<T, checked, scoped>();
+    }
 
-  return 0;
-}
+    return js_create_string_utf8(env, (const utf8_t *) name.data(), name.length(), &result.name);
+  }
+};
 
-template <typename T>
-static inline auto
-js_create_arraybuffer(js_env_t *env, const std::span<T> &data, js_arraybuffer_t &result) {
-  int err;
+template <auto fn>
+struct js_class_static_t {
+  std::string name;
 
-  std::span<T> view;
-  err = js_create_arraybuffer(env, data.size(), view, result);
-  if (err < 0) return err;
+  js_class_static_t(const std::string &name) : name(name) {}
 
-  std::copy(data.begin(), data.end(), view.begin());
+  js_class_static_t(const char *name) : name(name) {}
 
-  return 0;
-}
+  template <typename T, bool checked, bool scoped>
+  auto
+  create_descriptor(js_env_t *env, js_property_descriptor_t &result) const {
+    result.version = 0;
+    result.data = nullptr;
+    result.attributes = js_writable | js_configurable | js_static;
+    result.method = js_untyped_callback<fn, checked, scoped>();
+    result.getter = nullptr;
+    result.setter = nullptr;
+    result.value = nullptr;
 
-template <typename T>
+    return js_create_string_utf8(env, (const utf8_t *) name.data(), name.length(), &result.name);
+  }
+};
+
+template <typename T, auto constructor, bool checked = js_is_debug, bool scoped = true, typename... M>
 static inline auto
-js_create_arraybuffer(js_env_t *env, const std::vector<T> &data, js_arraybuffer_t &result) {
+js_define_class(js_env_t *env, const char *name, size_t len, js_class_t<T> &result, const M &...members) {
   int err;
 
-  std::span<T> view;
-  err = js_create_arraybuffer(env, data.size(), view, result);
-  if (err < 0) return err;
+  std::array<js_property_descriptor_t, sizeof...(M)> descriptors;
 
-  std::copy(data.begin(), data.end(), view.begin());
+  size_t i = 0;
 
-  return 0;
+  if (!(((err = members.template create_descriptor<T, checked, scoped>(env, descriptors[i++])) == 0) && ...)) return err;
+
+  auto callback = js_constructor_info_t<constructor>::template create<T, checked, scoped>();
+
+  return js_define_class(env, name, len, callback, nullptr, descriptors.data(), descriptors.size(), &result.value);
 }
 
-template <typename T>
+template <typename T, auto constructor, bool checked = js_is_debug, bool scoped = true, typename... M>
 static inline auto
-js_create_typedarray(js_env_t *env, size_t len, const js_arraybuffer_t &arraybuffer, size_t offset, js_typedarray_t<T> &result) {
-  return js_create_typedarray(env, js_typedarray_info_t<T>::type, len, arraybuffer.value, offset, &result.value);
+js_define_class(js_env_t *env, const std::string &name, js_class_t<T> &result, const M &...members) {
+  return js_define_class<T, constructor, checked, scoped>(env, name.data(), name.length(), result, members...);
 }
 
-template <typename T>
 static inline auto
-js_create_typedarray(js_env_t *env, size_t len, const js_arraybuffer_t &arraybuffer, js_typedarray_t<T> &result) {
-  return js_create_typedarray(env, len, arraybuffer, 0, result);
+js_run_script(js_env_t *env, const char *file, size_t len, int offset, const js_string_t &source, js_handle_t &result) {
+  return js_run_script(env, file, len, offset, source.value, &result.value);
 }
 
-template <typename T>
 static inline auto
-js_create_typedarray(js_env_t *env, size_t len, T *&data, js_typedarray_t<T> &result) {
-  int err;
-
-  js_arraybuffer_t arraybuffer;
-  err = js_create_arraybuffer(env, len, data, arraybuffer);
-  if (err < 0) return err;
-
-  return js_create_typedarray(env, len, arraybuffer, result);
+js_run_script(js_env_t *env, const std::string &file, int offset, const js_string_t &source, js_handle_t &result) {
+  return js_run_script(env, file.data(), file.length(), offset, source.value, &result.value);
 }
 
-template <typename T>
 static inline auto
-js_create_typedarray(js_env_t *env, size_t len, std::span<T> &view, js_typedarray_t<T> &result) {
-  int err;
-
-  js_arraybuffer_t arraybuffer;
-  err = js_create_arraybuffer(env, len, view, arraybuffer);
-  if (err < 0) return err;
-
-  return js_create_typedarray(env, len, arraybuffer, result);
+js_run_script(js_env_t *env, const js_string_t &source, js_handle_t &result) {
+  return js_run_script(env, nullptr, 0, 0, source.value, &result.value);
 }
 
 template <typename T>
 static inline auto
-js_create_typedarray(js_env_t *env, size_t len, js_typedarray_t<T> &result) {
-  int err;
-
-  js_arraybuffer_t arraybuffer;
-  err = js_create_arraybuffer<T>(env, len, arraybuffer);
-  if (err < 0) return err;
+js_create_reference(js_env_t *env, const T &value, js_persistent_t<T> &result) {
+  result.env = env;
 
-  return js_create_typedarray(env, len, arraybuffer, result);
+  return js_create_reference(env, value.value, 1, &result.ref);
 }
 
 template <typename T>
 static inline auto
-js_create_typedarray(js_env_t *env, T *&data, js_typedarray_t<uint8_t> &result) {
-  int err;
-
-  js_arraybuffer_t arraybuffer;
-  err = js_create_arraybuffer(env, data, arraybuffer);
-  if (err < 0) return err;
+js_create_weak_reference(js_env_t *env, const T &value, js_persistent_t<T> &result) {
+  result.env = env;
 
-  return js_create_typedarray(env, sizeof(T), arraybuffer, result);
+  return js_create_reference(env, value.value, 0, &result.ref);
 }
 
-template <typename T, size_t N>
+template <typename T>
 static inline auto
-js_create_typedarray(js_env_t *env, const T data[N], js_typedarray_t<T> &result) {
+js_get_reference_value(js_env_t *env, const js_persistent_t<T> &reference, T &result) {
   int err;
 
-  std::span<T> view;
-  err = js_create_typedarray(env, N, view, result);
+  js_value_t *value;
+  err = js_get_reference_value(env, reference.ref, &value);
   if (err < 0) return err;
 
-  std::copy(data, data + N, view.begin());
+  assert(value != nullptr);
+
+  result = T(value);
 
   return 0;
 }
 
-template <typename T, size_t N>
+template <typename T>
 static inline auto
-js_create_typedarray(js_env_t *env, const std::array<T, N> data, js_typedarray_t<T> &result) {
+js_get_reference_value(js_env_t *env, const js_persistent_t<T> &reference, std::optional<T> &result) {
   int err;
 
-  std::span<T> view;
-  err = js_create_typedarray(env, N, view, result);
+  js_value_t *value;
+  err = js_get_reference_value(env, reference.ref, &value);
   if (err < 0) return err;
 
-  std::copy(data.begin(), data.end(), view.begin());
+  result = value == nullptr ? std::nullopt : std::optional(T(value));
 
   return 0;
 }
 
 template <typename T>
 static inline auto
-js_create_typedarray(js_env_t *env, const std::span<T> &data, js_typedarray_t<T> &result) {
+js_reset_reference(js_env_t *env, js_persistent_t<T> &reference) {
   int err;
 
-  std::span<T> view;
-  err = js_create_typedarray(env, data.size(), view, result);
+  if (reference.ref == nullptr) return 0;
+
+  err = js_delete_reference(env, reference.ref);
   if (err < 0) return err;
 
-  std::copy(data.begin(), data.end(), view.begin());
+  reference.ref = nullptr;
 
   return 0;
 }
 
 template <typename T>
 static inline auto
-js_create_typedarray(js_env_t *env, const std::vector<T> &data, js_typedarray_t<T> &result) {
-  int err;
-
-  std::span<T> view;
-  err = js_create_typedarray(env, data.size(), view, result);
-  if (err < 0) return err;
-
-  std::copy(data.begin(), data.end(), view.begin());
-
-  return 0;
+js_reference_ref(js_env_t *env, const js_persistent_t<T> &reference, uint32_t &result) {
+  return js_reference_ref(env, reference.ref, &result);
 }
 
 template <typename T>
 static inline auto
-js_get_arraybuffer_info(js_env_t *env, const js_arraybuffer_t &arraybuffer, T *&data, size_t &len) {
-  int err;
-  err = js_get_arraybuffer_info(env, arraybuffer.value, (void **) &data, &len);
-  if (err < 0) return err;
-
-  assert(len % sizeof(T) == 0);
+js_reference_ref(js_env_t *env, const js_persistent_t<T> &reference) {
+  return js_reference_ref(env, reference.ref, nullptr);
+}
 
-  len /= sizeof(T);
+template <typename T>
+static inline auto
+js_reference_unref(js_env_t *env, const js_persistent_t<T> &reference, uint32_t &result) {
+  return js_reference_unref(env, reference.ref, &result);
+}
 
-  return 0;
+template <typename T>
+static inline auto
+js_reference_unref(js_env_t *env, const js_persistent_t<T> &reference) {
+  return js_reference_unref(env, reference.ref, nullptr);
 }
 
 template <typename T>
 static inline auto
-js_get_arraybuffer_info(js_env_t *env, const js_arraybuffer_t &arraybuffer, T *&data) {
+js_create_typedarray(js_env_t *env, js_typedarray_pool_t &pool, size_t len, T *&data, js_typedarray_t<T> &result) {
   int err;
 
-  size_t len;
-  err = js_get_arraybuffer_info(env, arraybuffer.value, (void **) &data, &len);
-  if (err < 0) return err;
+  auto size = len * sizeof(T);
 
-  assert(len == sizeof(T));
+  if (size > pool.cutoff) return js_create_typedarray(env, len, data, result);
 
-  return 0;
-}
+  js_arraybuffer_t arraybuffer;
 
-template <typename T>
-static inline auto
-js_get_arraybuffer_info(js_env_t *env, const js_arraybuffer_t &arraybuffer, std::span<T> &view) {
-  int err;
+  bool exhausted = pool.offset + size > pool.size;
 
-  T *data;
-  size_t len;
-  err = js_get_arraybuffer_info(env, arraybuffer, data, len);
-  if (err < 0) return err;
+  if (!exhausted) {
+    err = js_get_reference_value(env, pool.slab, arraybuffer);
+    if (err < 0) return err;
 
-  view = std::span(data, len);
+    err = js_is_detached_arraybuffer(env, arraybuffer, exhausted);
+    if (err < 0) return err;
+  }
 
-  return 0;
-}
+  if (exhausted) {
+    err = js_create_arraybuffer(env, pool.size, pool.data, arraybuffer);
+    if (err < 0) return err;
 
-template <typename T>
-static inline auto
-js_get_typedarray_info(js_env_t *env, js_typedarray_t<T> &typedarray, T *&data, size_t &len) {
-  return js_get_typedarray_info(env, typedarray.value, nullptr, (void **) &data, &len, nullptr, nullptr);
-}
+    js_persistent_t<js_arraybuffer_t> slab;
+    err = js_create_reference(env, arraybuffer, slab);
+    if (err < 0) return err;
 
-template <typename T>
-static inline auto
-js_get_typedarray_info(js_env_t *env, js_typedarray_t<uint8_t> &typedarray, T *&data) {
-  int err;
+    pool.slab = std::move(slab);
+    pool.offset = 0;
+  }
 
-  size_t len;
-  err = js_get_typedarray_info(env, typedarray.value, nullptr, (void **) &data, &len, nullptr, nullptr);
+  err = js_create_typedarray(env, len, arraybuffer, pool.offset, result);
   if (err < 0) return err;
 
-  assert(len == sizeof(T));
+  data = reinterpret_cast<T *>(pool.data + pool.offset);
+
+  pool.offset += (size + js_typedarray_pool_t::alignment - 1) & ~(js_typedarray_pool_t::alignment - 1);
 
   return 0;
 }
 
 template <typename T>
 static inline auto
-js_get_typedarray_info(js_env_t *env, js_typedarray_t<T> &typedarray, std::span<T> &view) {
+js_create_typedarray(js_env_t *env, js_typedarray_pool_t &pool, size_t len, std::span<T> &view, js_typedarray_t<T> &result) {
   int err;
 
   T *data;
-  size_t len;
-  err = js_get_typedarray_info(env, typedarray, data, len);
+  err = js_create_typedarray(env, pool, len, data, result);
   if (err < 0) return err;
 
   view = std::span(data, len);
@@ -2196,413 +5788,428 @@ js_get_typedarray_info(js_env_t *env, js_typedarray_t<T> &typedarray, std::span<
   return 0;
 }
 
+template <typename T>
 static inline auto
-js_get_value_bigint(js_env_t *env, const js_bigint_t &bigint, int64_t &result) {
-  return js_get_value_bigint_int64(env, bigint.value, &result, nullptr);
-}
-
-static inline auto
-js_get_value_bigint(js_env_t *env, const js_bigint_t &bigint, int64_t &result, bool &lossless) {
-  return js_get_value_bigint_int64(env, bigint.value, &result, &lossless);
-}
-
-static inline auto
-js_get_value_bigint(js_env_t *env, const js_bigint_t &bigint, uint64_t &result) {
-  return js_get_value_bigint_uint64(env, bigint.value, &result, nullptr);
-}
-
-static inline auto
-js_get_value_bigint(js_env_t *env, const js_bigint_t &bigint, uint64_t &result, bool &lossless) {
-  return js_get_value_bigint_uint64(env, bigint.value, &result, &lossless);
-}
-
-static inline auto
-js_get_value_string(js_env_t *env, const js_string_t &string, std::string &result) {
+js_create_typedarray(js_env_t *env, js_typedarray_pool_t &pool, const std::span<T> &data, js_typedarray_t<std::remove_const_t<T>> &result) {
   int err;
 
-  size_t len;
-  err = js_get_value_string_utf8(env, string.value, nullptr, 0, &len);
+  std::span<std::remove_const_t<T>> view;
+  err = js_create_typedarray(env, pool, data.size(), view, result);
   if (err < 0) return err;
 
-  result.resize(len);
+  std::copy(data.begin(), data.end(), view.begin());
 
-  return js_get_value_string_utf8(env, string.value, (utf8_t *) result.data(), result.length(), nullptr);
+  return 0;
 }
 
+template <typename T>
 static inline auto
-js_get_global(js_env_t *env, js_object_t &result) {
-  return js_get_global(env, &result.value);
+js_create_typedarray(js_env_t *env, js_typedarray_pool_t &pool, const std::vector<T> &data, js_typedarray_t<T> &result) {
+  return js_create_typedarray(env, pool, std::span<const T>(data), result);
 }
 
 static inline auto
-js_get_property(js_env_t *env, const js_object_t &object, const js_name_t &name, js_handle_t &result) {
-  return js_get_property(env, object.value, name.value, &result.value);
-}
+js_reset_typedarray_pool(js_env_t *env, js_typedarray_pool_t &pool) {
+  int err;
+  err = js_reset_reference(env, pool.slab);
+  if (err < 0) return err;
 
-static inline auto
-js_get_property(js_env_t *env, const js_object_t &object, const char *name, js_handle_t &result) {
-  return js_get_named_property(env, object.value, name, &result.value);
+  pool.data = nullptr;
+  pool.offset = pool.size;
+
+  return 0;
 }
 
-template <bool checked = js_is_debug, typename T>
 static inline auto
-js_get_property(js_env_t *env, const js_object_t &object, const js_name_t &name, T &result) {
+js_create_reference_pool(js_env_t *env, size_t capacity, js_reference_pool_t &result) {
   int err;
 
-  js_value_t *value;
-  err = js_get_property(env, object.value, name.value, &value);
+  js_value_t *values;
+  err = js_create_array_with_length(env, capacity, &values);
   if (err < 0) return err;
 
-  return js_type_info_t<T>::template unmarshall<checked>(env, value, result);
-}
+  js_ref_t *ref;
+  err = js_create_reference(env, values, 1, &ref);
+  if (err < 0) return err;
 
-template <bool checked = js_is_debug, typename T>
-static inline auto
-js_get_property(js_env_t *env, const js_object_t &object, const char *name, T &result) {
-  int err;
+  js_reference_pool_t pool;
 
-  js_value_t *value;
-  err = js_get_named_property(env, object.value, name, &value);
-  if (err < 0) return err;
+  pool.env = env;
+  pool.ref = ref;
+  pool.len = uint32_t(capacity);
+  pool.used.resize(capacity, false);
 
-  return js_type_info_t<T>::template unmarshall<checked>(env, value, result);
-}
+  for (uint32_t i = 0; i < capacity; i++) {
+    pool.free.push_back(i);
+  }
 
-static inline auto
-js_set_property(js_env_t *env, const js_object_t &object, const js_name_t &name, const js_handle_t &value) {
-  return js_set_property(env, object.value, name.value, value.value);
+  result = std::move(pool);
+
+  return 0;
 }
 
 static inline auto
-js_set_property(js_env_t *env, const js_object_t &object, const char *name, const js_handle_t &value) {
-  return js_set_named_property(env, object.value, name, value.value);
+js_create_reference_pool(js_env_t *env, js_reference_pool_t &result) {
+  return js_create_reference_pool(env, 0, result);
 }
 
-template <bool checked = js_is_debug, typename T>
-static inline auto
-js_set_property(js_env_t *env, const js_object_t &object, const js_name_t &name, const T &value) {
+static inline int
+js_check_reference_slot(js_env_t *env, const js_reference_pool_t &pool, uint32_t slot) {
   int err;
 
-  js_value_t *marshalled;
-  err = js_type_info_t<T>::template marshall<checked>(env, value, marshalled);
-  if (err < 0) return err;
+  if (slot < pool.len && pool.used[slot]) return 0;
+
+  err = js_throw_error(env, nullptr, "Reference slot is not in use");
+  assert(err == 0);
 
-  return js_set_property(env, object.value, name.value, marshalled);
+  return js_pending_exception;
 }
 
-template <bool checked = js_is_debug, typename T>
+template <typename T>
 static inline auto
-js_set_property(js_env_t *env, const js_object_t &object, const char *name, const T &value) {
+js_create_reference(js_env_t *env, js_reference_pool_t &pool, const T &value, uint32_t &result) {
   int err;
 
-  js_value_t *marshalled;
-  err = js_type_info_t<T>::template marshall<checked>(env, value, marshalled);
+  if (pool.ref == nullptr) {
+    err = js_create_reference_pool(env, pool);
+    if (err < 0) return err;
+  }
+
+  js_value_t *values;
+  err = js_get_reference_value(env, pool.ref, &values);
   if (err < 0) return err;
 
-  return js_set_named_property(env, object.value, name, marshalled);
-}
+  uint32_t slot;
 
-template <auto fn, bool checked = js_is_debug, bool scoped = true>
-static inline auto
-js_set_property(js_env_t *env, const js_object_t &object, const js_name_t &name) {
-  int err;
+  if (pool.free.empty()) {
+    slot = pool.len;
+  } else {
+    slot = pool.free.front();
+  }
 
-  js_handle_t value;
-  err = js_function_info_t<fn>::template marshall<checked, scoped>(env, nullptr, 0, value);
+  err = js_set_element(env, values, slot, value.value);
   if (err < 0) return err;
 
-  return js_set_property(env, object, name, value);
+  if (pool.free.empty()) {
+    pool.len++;
+    pool.used.push_back(true);
+  } else {
+    pool.free.pop_front();
+    pool.used[slot] = true;
+  }
+
+  result = slot;
+
+  return 0;
 }
 
-template <auto fn, bool checked = js_is_debug, bool scoped = true>
+template <typename T>
 static inline auto
-js_set_property(js_env_t *env, const js_object_t &object, const char *name) {
+js_get_reference_value(js_env_t *env, const js_reference_pool_t &pool, uint32_t slot, T &result) {
   int err;
 
-  js_handle_t value;
-  err = js_function_info_t<fn>::template marshall<checked, scoped>(env, name, -1, value);
+  err = js_check_reference_slot(env, pool, slot);
   if (err < 0) return err;
 
-  return js_set_named_property(env, object, name, value);
-}
+  js_value_t *values;
+  err = js_get_reference_value(env, pool.ref, &values);
+  if (err < 0) return err;
 
-static inline auto
-js_get_element(js_env_t *env, const js_object_t &object, uint32_t index, js_handle_t &result) {
-  return js_get_element(env, object.value, index, &result.value);
+  js_value_t *value;
+  err = js_get_element(env, values, slot, &value);
+  if (err < 0) return err;
+
+  result = T(value);
+
+  return 0;
 }
 
-template <bool checked = js_is_debug, typename T>
 static inline auto
-js_get_element(js_env_t *env, const js_object_t &object, uint32_t index, T &result) {
+js_clear_reference(js_env_t *env, js_reference_pool_t &pool, uint32_t slot) {
   int err;
 
-  js_value_t *value;
-  err = js_get_element(env, object.value, index, &value);
+  err = js_check_reference_slot(env, pool, slot);
   if (err < 0) return err;
 
-  return js_type_info_t<T>::template unmarshall<checked>(env, value, result);
-}
+  js_value_t *values;
+  err = js_get_reference_value(env, pool.ref, &values);
+  if (err < 0) return err;
 
-static inline auto
-js_set_element(js_env_t *env, const js_object_t &object, uint32_t index, const js_handle_t &value) {
-  return js_set_element(env, object.value, index, value.value);
+  js_value_t *undefined;
+  err = js_get_undefined(env, &undefined);
+  if (err < 0) return err;
+
+  err = js_set_element(env, values, slot, undefined);
+  if (err < 0) return err;
+
+  pool.used[slot] = false;
+
+  return 0;
 }
 
-template <bool checked = js_is_debug, typename T>
 static inline auto
-js_set_element(js_env_t *env, const js_object_t &object, uint32_t index, const T &value) {
+js_delete_reference(js_env_t *env, js_reference_pool_t &pool, uint32_t slot) {
   int err;
-
-  js_value_t *marshalled;
-  err = js_type_info_t<T>::template marshall<checked>(env, value, marshalled);
+  err = js_clear_reference(env, pool, slot);
   if (err < 0) return err;
 
-  return js_set_element(env, object.value, index, marshalled);
+  pool.free.push_back(slot);
+
+  return 0;
 }
 
-template <auto fn, bool checked = js_is_debug, bool scoped = true>
 static inline auto
-js_set_element(js_env_t *env, const js_object_t &object, uint32_t index) {
+js_reset_reference_pool(js_env_t *env, js_reference_pool_t &pool) {
   int err;
 
-  js_handle_t value;
-  err = js_function_info_t<fn>::template marshall<checked, scoped>(env, nullptr, 0, value);
+  if (pool.ref == nullptr) return 0;
+
+  err = js_delete_reference(env, pool.ref);
   if (err < 0) return err;
 
-  return js_set_element(env, object, index, value);
+  pool.ref = nullptr;
+  pool.free.clear();
+  pool.used.clear();
+  pool.len = 0;
+
+  return 0;
 }
 
-template <bool checked = js_is_debug, typename T, size_t N>
+template <typename T>
 static inline auto
-js_get_array_elements(js_env_t *env, const js_array_t &array, T result[N]) {
+js_create_handle_table(js_env_t *env, size_t capacity, js_handle_table_t<T> &result) {
   int err;
 
-  js_value_t *values[N];
-  uint32_t len;
-  err = js_get_array_elements(env, array.value, values, N, 0, &len);
+  assert(capacity <= js_handle_table_t<T>::index_mask);
+
+  js_handle_table_t<T> table;
+  err = js_create_reference_pool(env, capacity, table.pool);
   if (err < 0) return err;
 
-  assert(len == N);
+  table.generations.resize(capacity, 1);
 
-  for (uint32_t i = 0; i < N; i++) {
-    err = js_type_info_t<T>::template unmarshall<checked>(env, values[i], result[i]);
-    if (err < 0) return err;
-  }
+  result = std::move(table);
 
   return 0;
 }
 
-template <bool checked = js_is_debug, typename T, size_t N>
+template <typename T>
 static inline auto
-js_get_array_elements(js_env_t *env, const js_array_t &array, std::array<T, N> &result) {
+js_create_handle_table(js_env_t *env, js_handle_table_t<T> &result) {
+  return js_create_handle_table(env, 0, result);
+}
+
+template <typename T>
+static inline auto
+js_create_handle(js_env_t *env, js_handle_table_t<T> &table, const T &value, uint32_t &result) {
   int err;
 
-  js_value_t *values[N];
-  uint32_t len;
-  err = js_get_array_elements(env, array.value, values, N, 0, &len);
-  if (err < 0) return err;
+  uint32_t slot;
 
-  assert(len == N);
+  for (;;) {
+    err = js_create_reference(env, table.pool, value, slot);
+    if (err < 0) return err;
 
-  for (uint32_t i = 0; i < N; i++) {
-    err = js_type_info_t<T>::template unmarshall<checked>(env, values[i], result[i]);
+    assert(slot <= js_handle_table_t<T>::index_mask);
+
+    if (slot == table.generations.size()) table.generations.push_back(1);
+
+    if (table.generations[slot] != 0) break;
+
+    err = js_clear_reference(env, table.pool, slot);
     if (err < 0) return err;
   }
 
+  result = uint32_t(table.generations[slot]) << js_handle_table_t<T>::index_bits | slot;
+
   return 0;
 }
 
-template <bool checked = js_is_debug, typename T>
+template <typename T>
 static inline auto
-js_get_array_elements(js_env_t *env, const js_array_t &array, std::vector<T> &result) {
-  int err;
+js_is_handle_valid(const js_handle_table_t<T> &table, uint32_t id) {
+  auto slot = id & js_handle_table_t<T>::index_mask;
 
-  uint32_t len;
-  err = js_get_array_length(env, array.value, &len);
-  if (err < 0) return err;
+  auto generation = id >> js_handle_table_t<T>::index_bits;
 
-  std::vector<js_value_t *> values(len);
-  err = js_get_array_elements(env, array.value, values.data(), len, 0, &len);
-  if (err < 0) return err;
+  return generation != 0 && slot < table.generations.size() && table.generations[slot] == generation;
+}
 
-  result.resize(len);
+template <typename T>
+static inline int
+js_get_handle_value(js_env_t *env, const js_handle_table_t<T> &table, uint32_t id, T &result) {
+  int err;
 
-  for (uint32_t i = 0; i < len; i++) {
-    err = js_type_info_t<T>::template unmarshall<checked>(env, values[i], result[i]);
-    if (err < 0) return err;
+  if (!js_is_handle_valid(table, id)) {
+    err = js_throw_error(env, nullptr, "Handle is not valid");
+    assert(err == 0);
+
+    return js_pending_exception;
   }
 
-  return 0;
+  return js_get_reference_value(env, table.pool, id & js_handle_table_t<T>::index_mask, result);
 }
 
-template <bool checked = js_is_debug, typename T, size_t N>
+template <typename T>
 static inline auto
-js_set_array_elements(js_env_t *env, const js_array_t &array, const T values[N], size_t offset = 0) {
+js_get_handle_value(js_env_t *env, const js_handle_table_t<T> &table, uint32_t id, std::optional<T> &result) {
   int err;
 
-  js_value_t *marshalled[N];
+  if (!js_is_handle_valid(table, id)) {
+    result = std::nullopt;
 
-  for (uint32_t i = 0; i < N; i++) {
-    err = js_type_info_t<T>::template marshall<checked>(env, values[i], marshalled[i]);
-    if (err < 0) return err;
+    return 0;
   }
 
-  return js_set_array_elements(env, array.value, (const js_value_t **) marshalled, N, offset);
+  T value;
+  err = js_get_reference_value(env, table.pool, id & js_handle_table_t<T>::index_mask, value);
+  if (err < 0) return err;
+
+  result = value;
+
+  return 0;
 }
 
-template <bool checked = js_is_debug, typename T, size_t N>
+template <typename T>
 static inline auto
-js_set_array_elements(js_env_t *env, const js_array_t &array, const std::array<T, N> &values, size_t offset = 0) {
+js_delete_handle(js_env_t *env, js_handle_table_t<T> &table, uint32_t id) {
   int err;
 
-  js_value_t *marshalled[N];
+  if (!js_is_handle_valid(table, id)) return 0;
 
-  for (uint32_t i = 0; i < N; i++) {
-    err = js_type_info_t<T>::template marshall<checked>(env, values[i], marshalled[i]);
+  auto slot = id & js_handle_table_t<T>::index_mask;
+
+  auto &generation = table.generations[slot];
+
+  if (generation == js_handle_table_t<T>::generation_max) {
+    err = js_clear_reference(env, table.pool, slot);
     if (err < 0) return err;
+
+    generation = 0;
+  } else {
+    err = js_delete_reference(env, table.pool, slot);
+    if (err < 0) return err;
+
+    generation++;
   }
 
-  return js_set_array_elements(env, array.value, (const js_value_t **) marshalled, N, offset);
+  return 0;
 }
 
-template <bool checked = js_is_debug, typename T>
+template <typename T>
 static inline auto
-js_set_array_elements(js_env_t *env, const js_array_t &array, const std::vector<T> &values, size_t offset = 0) {
+js_reset_handle_table(js_env_t *env, js_handle_table_t<T> &table) {
   int err;
+  err = js_reset_reference_pool(env, table.pool);
+  if (err < 0) return err;
 
-  auto len = values.size();
-
-  std::vector<js_value_t *> marshalled(len);
+  for (auto &generation : table.generations) {
+    if (generation == 0) continue;
 
-  for (uint32_t i = 0; i < len; i++) {
-    err = js_type_info_t<T>::template marshall<checked>(env, values[i], marshalled[i]);
-    if (err < 0) return err;
+    generation = generation == js_handle_table_t<T>::generation_max ? 0 : generation + 1;
   }
 
-  return js_set_array_elements(env, array.value, (const js_value_t **) marshalled.data(), len, offset);
+  return 0;
 }
 
-template <bool checked = js_is_debug, typename T>
+template <typename K, typename T>
 static inline auto
-js_create_property_descriptor(js_env_t *env, const js_property_t<T> &property, js_property_descriptor_t &result) {
+js_get_weak_cache_value(js_env_t *env, js_weak_cache_t<K, T> &cache, const K &key, std::optional<T> &result) {
   int err;
 
-  js_property_descriptor_t descriptor;
+  auto &entries = cache.state->entries;
 
-  descriptor.version = 0;
-  descriptor.data = nullptr;
-  descriptor.attributes = js_writable | js_enumerable | js_configurable;
-  descriptor.method = nullptr;
-  descriptor.getter = nullptr;
-  descriptor.setter = nullptr;
+  auto entry = entries.find(key);
 
-  const auto &name = property.name;
+  if (entry == entries.end()) {
+    result = std::nullopt;
 
-  err = js_create_string_utf8(env, (const utf8_t *) name.data(), name.length(), &descriptor.name);
-  if (err < 0) return err;
+    return 0;
+  }
 
-  err = js_type_info_t<T>::template marshall<checked>(env, property.value, descriptor.value);
+  err = js_get_reference_value(env, entry->second.reference, result);
   if (err < 0) return err;
 
-  result = descriptor;
+  if (!result) entries.erase(entry);
 
   return 0;
 }
 
-template <bool checked = js_is_debug, typename T>
+template <typename K, typename T>
 static inline auto
-js_create_property_descriptor(js_env_t *env, const js_property_t<T> &property) {
+js_set_weak_cache_value(js_env_t *env, js_weak_cache_t<K, T> &cache, const K &key, const T &value) {
   int err;
 
-  js_property_descriptor_t descriptor;
-  err = js_create_property_descriptor<checked>(env, property, descriptor);
-  assert(err == 0);
+  auto entry = cache.state->entries.find(key);
 
-  return descriptor;
-}
+  if (entry != cache.state->entries.end()) {
+    std::optional<T> existing;
+    err = js_get_reference_value(env, entry->second.reference, existing);
+    if (err < 0) return err;
 
-template <bool checked = js_is_debug, typename... T>
-static inline auto
-js_define_properties(js_env_t *env, const js_object_t &object, const js_property_t<T>... properties) {
-  js_property_descriptor_t descriptors[] = {
-    js_create_property_descriptor<checked>(env, properties)...
-  };
+    if (existing) {
+      bool equals;
+      err = js_strict_equals(env, *existing, value, &equals);
+      if (err < 0) return err;
 
-  return js_define_properties(env, object.value, descriptors, sizeof...(T));
-}
+      if (equals) return 0;
+    }
+  }
 
-static inline auto
-js_run_script(js_env_t *env, const char *file, size_t len, int offset, const js_string_t &source, js_handle_t &result) {
-  return js_run_script(env, file, len, offset, source.value, &result.value);
-}
+  auto id = ++cache.state->id;
 
-static inline auto
-js_run_script(js_env_t *env, const std::string &file, int offset, const js_string_t &source, js_handle_t &result) {
-  return js_run_script(env, file.data(), file.length(), offset, source.value, &result.value);
-}
+  js_persistent_t<T> reference;
+  err = js_create_weak_reference(env, value, reference);
+  if (err < 0) return err;
 
-static inline auto
-js_run_script(js_env_t *env, const js_string_t &source, js_handle_t &result) {
-  return js_run_script(env, nullptr, 0, 0, source.value, &result.value);
-}
+  using eviction_t = typename js_weak_cache_t<K, T>::eviction_t;
 
-template <typename T>
-static inline auto
-js_create_reference(js_env_t *env, const T &value, js_persistent_t<T> &result) {
-  result.env = env;
+  auto eviction = new eviction_t{cache.state, key, id};
 
-  return js_create_reference(env, value.value, 1, &result.ref);
-}
+  err = js_add_finalizer(env, value.value, (void *) eviction, js_weak_cache_t<K, T>::evict, nullptr, nullptr);
 
-template <typename T>
-static inline auto
-js_create_weak_reference(js_env_t *env, const T &value, js_persistent_t<T> &result) {
-  result.env = env;
+  if (err < 0) {
+    delete eviction;
 
-  return js_create_reference(env, value.value, 0, &result.ref);
+    return err;
+  }
+
+  cache.state->entries.insert_or_assign(key, typename js_weak_cache_t<K, T>::entry_t{std::move(reference), id});
+
+  return 0;
 }
 
-template <typename T>
+template <typename K, typename T, typename F>
 static inline auto
-js_get_reference_value(js_env_t *env, const js_persistent_t<T> &reference, T &result) {
+js_get_weak_cache_value(js_env_t *env, js_weak_cache_t<K, T> &cache, const K &key, F create, T &result) {
   int err;
 
-  js_value_t *value;
-  err = js_get_reference_value(env, reference.ref, &value);
+  std::optional<T> cached;
+  err = js_get_weak_cache_value(env, cache, key, cached);
   if (err < 0) return err;
 
-  assert(value != nullptr);
-
-  result = T(value);
+  if (cached) {
+    result = *cached;
 
-  return 0;
-}
+    return 0;
+  }
 
-template <typename T>
-static inline auto
-js_get_reference_value(js_env_t *env, const js_persistent_t<T> &reference, std::optional<T> &result) {
-  int err;
+  T value;
+  err = create(env, key, value);
+  if (err < 0) return err;
 
-  js_value_t *value;
-  err = js_get_reference_value(env, reference.ref, &value);
+  err = js_set_weak_cache_value(env, cache, key, value);
   if (err < 0) return err;
 
-  result = value == nullptr ? std::nullopt : std::optional(T(value));
+  result = value;
 
   return 0;
 }
 
-template <typename T>
+template <typename K, typename T>
 static inline auto
-js_reset_reference(js_env_t *env, js_persistent_t<T> &reference) {
-  int err;
-
-  if (reference.ref == nullptr) return 0;
-
-  err = js_delete_reference(env, reference.ref);
-  if (err < 0) return err;
-
-  reference.ref = nullptr;
+js_delete_weak_cache_value(js_env_t *env, js_weak_cache_t<K, T> &cache, const K &key) {
+  cache.state->entries.erase(key);
 
   return 0;
 }
@@ -0,0 +1,93 @@
+#include <assert.h>
+#include <js.h>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  js_arraybuffer_t arraybuffer;
+  e = js_create_arraybuffer(env, 8, arraybuffer);
+  assert(e == 0);
+
+  js_dataview_t dataview;
+  e = js_create_dataview(env, 7, arraybuffer, 1, dataview);
+  assert(e == 0);
+
+  using frame = js_record_view_t<
+    js_field_t<uint16_t, std::endian::big>,
+    js_field_t<uint32_t, std::endian::little>,
+    js_field_t<uint8_t>>;
+
+  static_assert(frame::size == 7);
+  static_assert(frame::offsets[2] == 6);
+
+  frame view;
+  e = js_get_dataview_info(env, dataview, view);
+  assert(e == 0);
+
+  view.set<0>(0x0102);
+  view.set<1>(0x03040506);
+  view.set<2>(0x07);
+
+  std::span<uint8_t> bytes;
+  e = js_get_arraybuffer_info(env, arraybuffer, bytes);
+  assert(e == 0);
+
+  assert(bytes[1] == 0x01);
+  assert(bytes[2] == 0x02);
+  assert(bytes[3] == 0x06);
+  assert(bytes[6] == 0x03);
+  assert(bytes[7] == 0x07);
+
+  assert(view.get<0>() == 0x0102);
+  assert(view.get<1>() == 0x03040506);
+  assert(view.get<2>() == 0x07);
+
+  js_arraybuffer_t buffer;
+  size_t offset;
+  e = js_get_dataview_info(env, dataview, bytes, buffer, offset);
+  assert(e == 0);
+
+  assert(bytes.size() == 7);
+  assert(offset == 1);
+
+  js_dataview_t truncated;
+  e = js_create_dataview(env, 6, arraybuffer, 2, truncated);
+  assert(e == 0);
+
+  e = js_get_dataview_info(env, truncated, view);
+  assert(e == js_pending_exception);
+
+  js_value_t *error;
+  e = js_get_and_clear_last_exception(env, &error);
+  assert(e == 0);
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
@@ -0,0 +1,67 @@
+#include <assert.h>
+#include <js.h>
+#include <memory>
+#include <span>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  auto data = std::make_unique<uint32_t[]>(4);
+
+  data[3] = 42;
+
+  auto ptr = data.get();
+
+  js_arraybuffer_t arraybuffer;
+  e = js_create_external_arraybuffer(env, std::move(data), 4, arraybuffer);
+  assert(e == 0);
+
+  assert(data == nullptr);
+
+  std::span<uint32_t> view;
+  e = js_get_arraybuffer_info(env, arraybuffer, view);
+  assert(e == 0);
+
+  assert(view.data() == ptr);
+  assert(view.size() == 4);
+  assert(view[3] == 42);
+
+  std::unique_ptr<uint32_t> empty;
+
+  e = js_create_external_arraybuffer(env, std::move(empty), arraybuffer);
+  assert(e == js_pending_exception);
+
+  js_value_t *error;
+  e = js_get_and_clear_last_exception(env, &error);
+  assert(e == 0);
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
@@ -0,0 +1,56 @@
+#include <assert.h>
+#include <js.h>
+#include <stdint.h>
+#include <uv.h>
+#include <vector>
+
+#include "../include/jstl.h"
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  std::vector<uint8_t> data = {1, 2, 3};
+
+  data.reserve(1024);
+
+  js_arraybuffer_t arraybuffer;
+  e = js_create_external_arraybuffer(env, std::move(data), arraybuffer);
+  assert(e == 0);
+
+  std::span<uint8_t> view;
+  e = js_get_arraybuffer_info(env, arraybuffer, view);
+  assert(e == 0);
+
+  assert(view.size() == 3);
+
+  assert(view[0] == 1);
+  assert(view[1] == 2);
+  assert(view[2] == 3);
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
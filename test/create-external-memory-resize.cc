@@ -0,0 +1,55 @@
+#include <assert.h>
+#include <js.h>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  js_external_memory_t a(env, 1024);
+
+  assert(a.size == 1024);
+
+  e = js_resize_external_memory(env, a, 4096);
+  assert(e == 0);
+
+  assert(a.size == 4096);
+
+  js_external_memory_t b = std::move(a);
+
+  assert(a.size == 0);
+  assert(b.size == 4096);
+
+  e = js_resize_external_memory(env, b, 0);
+  assert(e == 0);
+
+  assert(b.size == 0);
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
@@ -0,0 +1,68 @@
+#include <assert.h>
+#include <js.h>
+#include <map>
+#include <stdint.h>
+#include <string>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+std::map<std::string, int32_t>
+on_call(js_env_t *env) {
+  return {{"foo", 1}, {"bar", 2}};
+}
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  js_function_t<std::map<std::string, int32_t>> fn;
+  e = js_create_function<on_call>(env, fn);
+  assert(e == 0);
+
+  js_object_t global;
+  e = js_get_global(env, global);
+  assert(e == 0);
+
+  js_object_t result;
+  e = js_call_function(env, global, fn, 0, NULL, result);
+  assert(e == 0);
+
+  int32_t foo;
+  e = js_get_property(env, result, "foo", foo);
+  assert(e == 0);
+
+  assert(foo == 1);
+
+  int32_t bar;
+  e = js_get_property(env, result, "bar", bar);
+  assert(e == 0);
+
+  assert(bar == 2);
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
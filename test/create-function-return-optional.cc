@@ -0,0 +1,66 @@
+#include <assert.h>
+#include <js.h>
+#include <optional>
+#include <stdint.h>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+std::optional<int32_t>
+on_call_value(js_env_t *env) {
+  return 42;
+}
+
+std::optional<int32_t>
+on_call_empty(js_env_t *env) {
+  return std::nullopt;
+}
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  js_function_t<std::optional<int32_t>> fn;
+  e = js_create_function<on_call_value>(env, fn);
+  assert(e == 0);
+
+  std::optional<int32_t> result;
+  e = js_call_function(env, fn, result);
+  assert(e == 0);
+
+  assert(result == 42);
+
+  e = js_create_function<on_call_empty>(env, fn);
+  assert(e == 0);
+
+  e = js_call_function(env, fn, result);
+  assert(e == 0);
+
+  assert(!result.has_value());
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
@@ -0,0 +1,76 @@
+#include <assert.h>
+#include <js.h>
+#include <string>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+std::string
+on_ascii(js_env_t *env) {
+  return std::string(100, 'x');
+}
+
+std::string
+on_utf8(js_env_t *env) {
+  return std::string(40, 'x') + "h\xc3\xa6r \xe2\x82\xac";
+}
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  js_function_t<std::string> ascii;
+  e = js_create_function<on_ascii>(env, ascii);
+  assert(e == 0);
+
+  std::string result;
+  e = js_call_function(env, ascii, result);
+  assert(e == 0);
+
+  assert(result == std::string(100, 'x'));
+
+  js_function_t<std::string> utf8;
+  e = js_create_function<on_utf8>(env, utf8);
+  assert(e == 0);
+
+  e = js_call_function(env, utf8, result);
+  assert(e == 0);
+
+  assert(result == std::string(40, 'x') + "h\xc3\xa6r \xe2\x82\xac");
+
+  js_string_t string;
+  e = js_create_string(env, std::string("h\xc3\xa6r"), string);
+  assert(e == 0);
+
+  std::string value;
+  e = js_get_value_string(env, string, value);
+  assert(e == 0);
+
+  assert(value == "h\xc3\xa6r");
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
@@ -0,0 +1,92 @@
+#include <assert.h>
+#include <js.h>
+#include <memory>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+static bool finalized = false;
+
+struct value_t {
+  int value;
+
+  ~value_t() {
+    finalized = true;
+  }
+};
+
+template <>
+struct js_external_info_t<value_t> {
+  static auto
+  size(const value_t &) {
+    return 1024;
+  }
+};
+
+std::unique_ptr<value_t>
+on_call(js_env_t *env) {
+  return std::make_unique<value_t>(42);
+}
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  int64_t before;
+  e = js_adjust_external_memory(env, 0, &before);
+  assert(e == 0);
+
+  js_function_t<std::unique_ptr<value_t>> fn;
+  e = js_create_function<on_call>(env, fn);
+  assert(e == 0);
+
+  js_object_t global;
+  e = js_get_global(env, global);
+  assert(e == 0);
+
+  js_external_t result;
+  e = js_call_function(env, global, fn, 0, NULL, result);
+  assert(e == 0);
+
+  value_t *value;
+  e = js_get_value_external(env, result, (void **) &value);
+  assert(e == 0);
+
+  assert(value->value == 42);
+
+  int64_t after;
+  e = js_adjust_external_memory(env, 0, &after);
+  assert(e == 0);
+
+  assert(after - before == 1024);
+
+  assert(!finalized);
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  assert(finalized);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
@@ -0,0 +1,78 @@
+#include <assert.h>
+#include <js.h>
+#include <span>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+static size_t total = 0;
+
+void
+on_call(js_env_t *env, js_arraybuffer_view_t view) {
+  int e;
+
+  std::span<std::byte> data;
+  js_arraybuffer_t arraybuffer;
+  size_t offset;
+  e = js_get_arraybuffer_view_info(env, view, data, arraybuffer, offset);
+  assert(e == 0);
+
+  assert(offset == 4);
+
+  total += data.size();
+}
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  js_arraybuffer_t arraybuffer;
+  e = js_create_arraybuffer(env, 16, arraybuffer);
+  assert(e == 0);
+
+  js_typedarray_t<uint16_t> typedarray;
+  e = js_create_typedarray(env, 3, arraybuffer, 4, typedarray);
+  assert(e == 0);
+
+  js_dataview_t dataview;
+  e = js_create_dataview(env, 5, arraybuffer, 4, dataview);
+  assert(e == 0);
+
+  js_function_t<void, js_arraybuffer_view_t> fn;
+  e = js_create_function<on_call>(env, fn);
+  assert(e == 0);
+
+  e = js_call_function(env, fn, js_arraybuffer_view_t(typedarray.value));
+  assert(e == 0);
+
+  e = js_call_function(env, fn, js_arraybuffer_view_t(dataview.value));
+  assert(e == 0);
+
+  assert(total == 3 * sizeof(uint16_t) + 5);
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
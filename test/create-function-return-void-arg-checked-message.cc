@@ -0,0 +1,96 @@
+#include <assert.h>
+#include <js.h>
+#include <string>
+#include <string_view>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+static_assert(std::string_view(js_argument_error_t<2, js_typedarray_t<uint8_t>>::message.data()) == "Argument 2 must be of type 'uint8array'");
+
+static_assert(std::string_view(js_argument_error_t<12, std::string>::message.data()) == "Argument 12 must be of type 'string'");
+
+void
+on_call(js_env_t *env, int32_t n, js_typedarray_t<uint8_t> data) {
+  assert(false);
+}
+
+void
+on_call_both(js_env_t *env, js_typedarray_t<uint8_t> data, std::string s) {
+  assert(false);
+}
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  js_function_t<void, int32_t, js_typedarray_t<uint8_t>> fn;
+  e = js_create_function<on_call, true>(env, fn);
+  assert(e == 0);
+
+  js_value_t *global;
+  e = js_get_global(env, &global);
+  assert(e == 0);
+
+  js_value_t *argv[2];
+
+  e = js_create_int32(env, 1, &argv[0]);
+  assert(e == 0);
+
+  e = js_create_int32(env, 2, &argv[1]);
+  assert(e == 0);
+
+  e = js_call_function(env, global, fn.value, 2, argv, NULL);
+  assert(e == js_pending_exception);
+
+  js_value_t *error;
+  e = js_get_and_clear_last_exception(env, &error);
+  assert(e == 0);
+
+  std::string message;
+  e = js_get_property(env, js_object_t(error), "message", message);
+  assert(e == 0);
+
+  assert(message == "Argument 2 must be of type 'uint8array'");
+
+  js_function_t<void, js_typedarray_t<uint8_t>, std::string> both;
+  e = js_create_function<on_call_both, true>(env, both);
+  assert(e == 0);
+
+  e = js_call_function(env, global, both.value, 2, argv, NULL);
+  assert(e == js_pending_exception);
+
+  e = js_get_and_clear_last_exception(env, &error);
+  assert(e == 0);
+
+  e = js_get_property(env, js_object_t(error), "message", message);
+  assert(e == 0);
+
+  assert(message == "Argument 1 must be of type 'uint8array'");
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
@@ -0,0 +1,87 @@
+#include <assert.h>
+#include <js.h>
+#include <string>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+static int calls = 0;
+
+void
+on_call(js_env_t *env, bool flag, double n, std::string s, int32_t i) {
+  assert(flag == true);
+  assert(n == 1.5);
+  assert(s == "hello");
+  assert(i == 42);
+
+  calls++;
+}
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  js_function_t<void, bool, double, std::string, int32_t> fn;
+  e = js_create_function<on_call, true>(env, fn);
+  assert(e == 0);
+
+  js_value_t *global;
+  e = js_get_global(env, &global);
+  assert(e == 0);
+
+  js_value_t *argv[4];
+
+  e = js_get_boolean(env, true, &argv[0]);
+  assert(e == 0);
+
+  e = js_create_double(env, 1.5, &argv[1]);
+  assert(e == 0);
+
+  e = js_create_string_utf8(env, (const utf8_t *) "hello", -1, &argv[2]);
+  assert(e == 0);
+
+  e = js_create_int32(env, 42, &argv[3]);
+  assert(e == 0);
+
+  e = js_call_function(env, global, fn.value, 4, argv, NULL);
+  assert(e == 0);
+
+  assert(calls == 1);
+
+  std::swap(argv[1], argv[2]);
+
+  e = js_call_function(env, global, fn.value, 4, argv, NULL);
+  assert(e == js_pending_exception);
+
+  assert(calls == 1);
+
+  js_value_t *error;
+  e = js_get_and_clear_last_exception(env, &error);
+  assert(e == 0);
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
@@ -0,0 +1,51 @@
+#include <assert.h>
+#include <js.h>
+#include <stdint.h>
+#include <utility>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+void
+on_call(js_env_t *env, std::pair<int32_t, double> pair) {
+  assert(pair.first == 42);
+  assert(pair.second == 4.2);
+}
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  js_function_t<void, std::pair<int32_t, double>> fn;
+  e = js_create_function<on_call>(env, fn);
+  assert(e == 0);
+
+  e = js_call_function(env, fn, std::pair<int32_t, double>(42, 4.2));
+  assert(e == 0);
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
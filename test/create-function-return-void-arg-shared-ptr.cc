@@ -0,0 +1,70 @@
+#include <assert.h>
+#include <js.h>
+#include <memory>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+void
+on_call(js_env_t *env, std::shared_ptr<int> ptr) {
+  assert(*ptr == 42);
+
+  assert(ptr.use_count() > 1);
+}
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  auto value = std::make_shared<int>(42);
+
+  js_function_t<void, std::shared_ptr<int>> fn;
+  e = js_create_function<on_call>(env, fn);
+  assert(e == 0);
+
+  e = js_call_function(env, fn, value);
+  assert(e == 0);
+
+  static int raw = 42;
+
+  js_value_t *external;
+  e = js_create_external(env, (void *) &raw, NULL, NULL, &external);
+  assert(e == 0);
+
+  js_value_t *global;
+  e = js_get_global(env, &global);
+  assert(e == 0);
+
+  e = js_call_function(env, global, fn.value, 1, &external, NULL);
+  assert(e == js_pending_exception);
+
+  js_value_t *error;
+  e = js_get_and_clear_last_exception(env, &error);
+  assert(e == 0);
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
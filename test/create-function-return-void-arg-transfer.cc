@@ -0,0 +1,145 @@
+#include <assert.h>
+#include <js.h>
+#include <span>
+#include <string>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+static std::shared_ptr<js_arraybuffer_backing_store_t> transferred;
+
+void
+on_call(js_env_t *env, js_transfer_t<std::span<uint8_t>> transfer) {
+  assert(transfer.value.size() == 4);
+  assert(transfer.value[3] == 42);
+
+  transferred = transfer.backing_store;
+}
+
+void
+on_call_invalid(js_env_t *env, js_transfer_t<std::span<uint8_t>> transfer, int32_t n) {
+  assert(false);
+}
+
+void
+on_call_pair(js_env_t *env, js_transfer_t<std::span<uint8_t>> a, js_transfer_t<std::span<uint8_t>> b) {
+  assert(false);
+}
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  std::span<uint8_t> view;
+  js_arraybuffer_t arraybuffer;
+  e = js_create_arraybuffer(env, 4, view, arraybuffer);
+  assert(e == 0);
+
+  view[3] = 42;
+
+  js_function_t<void, js_transfer_t<std::span<uint8_t>>> fn;
+  e = js_create_function<on_call>(env, fn);
+  assert(e == 0);
+
+  js_value_t *global;
+  e = js_get_global(env, &global);
+  assert(e == 0);
+
+  js_value_t *argv[1] = {arraybuffer.value};
+  e = js_call_function(env, global, fn.value, 1, argv, NULL);
+  assert(e == 0);
+
+  bool is_detached;
+  e = js_is_detached_arraybuffer(env, arraybuffer, is_detached);
+  assert(e == 0);
+
+  assert(is_detached);
+
+  assert(transferred);
+  assert(view[3] == 42);
+
+  transferred.reset();
+
+  js_arraybuffer_t other;
+  e = js_create_arraybuffer(env, 4, other);
+  assert(e == 0);
+
+  js_function_t<void, js_transfer_t<std::span<uint8_t>>, int32_t> invalid;
+  e = js_create_function<on_call_invalid, true>(env, invalid);
+  assert(e == 0);
+
+  js_value_t *args[2] = {other.value};
+
+  e = js_create_string_utf8(env, (const utf8_t *) "1", 1, &args[1]);
+  assert(e == 0);
+
+  e = js_call_function(env, global, invalid.value, 2, args, NULL);
+  assert(e == js_pending_exception);
+
+  js_value_t *error;
+  e = js_get_and_clear_last_exception(env, &error);
+  assert(e == 0);
+
+  e = js_is_detached_arraybuffer(env, other, is_detached);
+  assert(e == 0);
+
+  assert(!is_detached);
+
+  e = js_create_int32(env, 1, &args[0]);
+  assert(e == 0);
+
+  e = js_call_function(env, global, invalid.value, 2, args, NULL);
+  assert(e == js_pending_exception);
+
+  e = js_get_and_clear_last_exception(env, &error);
+  assert(e == 0);
+
+  std::string message;
+  e = js_get_property(env, js_object_t(error), "message", message);
+  assert(e == 0);
+
+  assert(message == "Argument 1 must be of type 'arraybuffer'");
+
+  js_function_t<void, js_transfer_t<std::span<uint8_t>>, js_transfer_t<std::span<uint8_t>>> pair;
+  e = js_create_function<on_call_pair, true>(env, pair);
+  assert(e == 0);
+
+  js_value_t *buffers[2] = {other.value, arraybuffer.value};
+
+  e = js_call_function(env, global, pair.value, 2, buffers, NULL);
+  assert(e == js_pending_exception);
+
+  e = js_get_and_clear_last_exception(env, &error);
+  assert(e == 0);
+
+  e = js_is_detached_arraybuffer(env, other, is_detached);
+  assert(e == 0);
+
+  assert(!is_detached);
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
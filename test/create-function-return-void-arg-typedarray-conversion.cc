@@ -0,0 +1,67 @@
+#include <assert.h>
+#include <js.h>
+#include <span>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+static float sum = 0;
+
+void
+on_call(js_env_t *env, js_typedarray_conversion_t<float, double> samples) {
+  for (auto sample : samples.value) sum += sample;
+}
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  std::span<double> view;
+  js_typedarray_t<double> typedarray;
+  e = js_create_typedarray(env, 5, view, typedarray);
+  assert(e == 0);
+
+  for (size_t i = 0; i < view.size(); i++) {
+    view[i] = double(i) + 0.5;
+  }
+
+  js_function_t<void, js_typedarray_conversion_t<float, double>> fn;
+  e = js_create_function<on_call>(env, fn);
+  assert(e == 0);
+
+  js_value_t *global;
+  e = js_get_global(env, &global);
+  assert(e == 0);
+
+  js_value_t *argv[1] = {typedarray.value};
+  e = js_call_function(env, global, fn.value, 1, argv, NULL);
+  assert(e == 0);
+
+  assert(sum == 12.5f);
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
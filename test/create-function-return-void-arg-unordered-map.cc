@@ -0,0 +1,75 @@
+#include <assert.h>
+#include <js.h>
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+void
+on_call(js_env_t *env, std::unordered_map<int32_t, std::string> map) {
+  assert(map.size() == 2);
+
+  assert(map[1] == "foo");
+  assert(map[2] == "bar");
+}
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  std::unordered_map<int32_t, std::string> map = {{1, "foo"}, {2, "bar"}};
+
+  js_function_t<void, std::unordered_map<int32_t, std::string>> fn;
+  e = js_create_function<on_call>(env, fn);
+  assert(e == 0);
+
+  e = js_call_function(env, fn, map);
+  assert(e == 0);
+
+  js_function_t<void, std::unordered_map<int32_t, std::string>> checked;
+  e = js_create_function<on_call, true>(env, checked);
+  assert(e == 0);
+
+  js_value_t *object;
+  e = js_create_object(env, &object);
+  assert(e == 0);
+
+  js_value_t *global;
+  e = js_get_global(env, &global);
+  assert(e == 0);
+
+  e = js_call_function(env, global, checked.value, 1, &object, NULL);
+  assert(e == js_pending_exception);
+
+  js_value_t *error;
+  e = js_get_and_clear_last_exception(env, &error);
+  assert(e == 0);
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
@@ -0,0 +1,110 @@
+#include <assert.h>
+#include <js.h>
+#include <optional>
+#include <stdint.h>
+#include <string>
+#include <string_view>
+#include <uv.h>
+#include <variant>
+
+#include "../include/jstl.h"
+
+using variant = std::variant<std::optional<int32_t>, std::string>;
+
+static_assert(js_argument_check_t<variant>::label == "int32 | undefined | string");
+
+static int calls = 0;
+
+void
+on_call(js_env_t *env, variant value) {
+  switch (calls++) {
+  case 0:
+    assert(!std::get<std::optional<int32_t>>(value).has_value());
+    break;
+  case 1:
+    assert(std::get<std::optional<int32_t>>(value) == 42);
+    break;
+  case 2:
+    assert(std::get<std::string>(value) == "hello");
+    break;
+  default:
+    assert(false);
+  }
+}
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  js_function_t<void, variant> fn;
+  e = js_create_function<on_call, true>(env, fn);
+  assert(e == 0);
+
+  js_value_t *global;
+  e = js_get_global(env, &global);
+  assert(e == 0);
+
+  js_value_t *argv[1];
+
+  e = js_get_undefined(env, &argv[0]);
+  assert(e == 0);
+
+  e = js_call_function(env, global, fn.value, 1, argv, NULL);
+  assert(e == 0);
+
+  e = js_create_int32(env, 42, &argv[0]);
+  assert(e == 0);
+
+  e = js_call_function(env, global, fn.value, 1, argv, NULL);
+  assert(e == 0);
+
+  e = js_create_string_utf8(env, (const utf8_t *) "hello", -1, &argv[0]);
+  assert(e == 0);
+
+  e = js_call_function(env, global, fn.value, 1, argv, NULL);
+  assert(e == 0);
+
+  assert(calls == 3);
+
+  e = js_get_boolean(env, true, &argv[0]);
+  assert(e == 0);
+
+  e = js_call_function(env, global, fn.value, 1, argv, NULL);
+  assert(e == js_pending_exception);
+
+  js_value_t *error;
+  e = js_get_and_clear_last_exception(env, &error);
+  assert(e == 0);
+
+  std::string message;
+  e = js_get_property(env, js_object_t(error), "message", message);
+  assert(e == 0);
+
+  assert(message == "Argument 1 must be of type 'int32 | undefined | string'");
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
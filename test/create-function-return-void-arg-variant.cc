@@ -0,0 +1,73 @@
+#include <assert.h>
+#include <js.h>
+#include <stdint.h>
+#include <string>
+#include <uv.h>
+#include <variant>
+
+#include "../include/jstl.h"
+
+static int calls = 0;
+
+void
+on_call(js_env_t *env, std::variant<std::monostate, int32_t, std::string> value) {
+  switch (calls++) {
+  case 0:
+    assert(std::get<int32_t>(value) == 42);
+    break;
+  case 1:
+    assert(std::get<std::string>(value) == "hello");
+    break;
+  case 2:
+    assert(std::holds_alternative<std::monostate>(value));
+    break;
+  }
+}
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  using variant = std::variant<std::monostate, int32_t, std::string>;
+
+  js_function_t<void, variant> fn;
+  e = js_create_function<on_call>(env, fn);
+  assert(e == 0);
+
+  e = js_call_function<true>(env, fn, variant(int32_t(42)));
+  assert(e == 0);
+
+  e = js_call_function<true>(env, fn, variant(std::string("hello")));
+  assert(e == 0);
+
+  e = js_call_function<true>(env, fn, variant());
+  assert(e == 0);
+
+  assert(calls == 3);
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
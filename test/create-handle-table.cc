@@ -0,0 +1,114 @@
+#include <assert.h>
+#include <js.h>
+#include <optional>
+#include <set>
+#include <stdint.h>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  js_handle_table_t<js_object_t> table;
+  e = js_create_handle_table(env, table);
+  assert(e == 0);
+
+  js_object_t object;
+  e = js_create_object(env, object);
+  assert(e == 0);
+
+  uint32_t a;
+  e = js_create_handle(env, table, object, a);
+  assert(e == 0);
+
+  assert(js_is_handle_valid(table, a));
+
+  js_object_t value;
+  e = js_get_handle_value(env, table, a, value);
+  assert(e == 0);
+
+  bool equals;
+  e = js_strict_equals(env, value, object, &equals);
+  assert(e == 0);
+
+  assert(equals);
+
+  e = js_delete_handle(env, table, a);
+  assert(e == 0);
+
+  assert(!js_is_handle_valid(table, a));
+
+  uint32_t b;
+  e = js_create_handle(env, table, object, b);
+  assert(e == 0);
+
+  assert(a != b);
+
+  std::optional<js_object_t> stale;
+  e = js_get_handle_value(env, table, a, stale);
+  assert(e == 0);
+
+  assert(!stale.has_value());
+
+  e = js_get_handle_value(env, table, a, value);
+  assert(e == js_pending_exception);
+
+  js_value_t *error;
+  e = js_get_and_clear_last_exception(env, &error);
+  assert(e == 0);
+
+  std::set<uint32_t> ids = {a, b};
+
+  for (int i = 0; i < 1000; i++) {
+    uint32_t c;
+    e = js_create_handle(env, table, object, c);
+    assert(e == 0);
+
+    assert(ids.insert(c).second);
+
+    e = js_delete_handle(env, table, c);
+    assert(e == 0);
+  }
+
+  e = js_reset_handle_table(env, table);
+  assert(e == 0);
+
+  assert(!js_is_handle_valid(table, b));
+
+  uint32_t d;
+  e = js_create_handle(env, table, object, d);
+  assert(e == 0);
+
+  assert(ids.insert(d).second);
+
+  e = js_reset_handle_table(env, table);
+  assert(e == 0);
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
@@ -0,0 +1,67 @@
+#include <assert.h>
+#include <js.h>
+#include <stdint.h>
+#include <string>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  js_string_t key;
+  e = js_create_string(env, std::string("bar"), key);
+  assert(e == 0);
+
+  js_object_t object;
+  e = js_create_object(env, object, js_property_t<int32_t>("foo", 1), js_property_t<int32_t>(key, 2), js_property_t<int32_t>(std::string("baz"), 3));
+  assert(e == 0);
+
+  js_object_t global;
+  e = js_get_global(env, global);
+  assert(e == 0);
+
+  e = js_set_property(env, global, "object", object);
+  assert(e == 0);
+
+  js_string_t source;
+  e = js_create_string(env, "Object.keys(object).join() === 'foo,bar,baz' ? object.foo + object.bar + object.baz : -1", source);
+  assert(e == 0);
+
+  js_handle_t result;
+  e = js_run_script(env, source, result);
+  assert(e == 0);
+
+  int32_t value;
+  e = js_get_value_int32(env, result, &value);
+  assert(e == 0);
+
+  assert(value == 6);
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
@@ -0,0 +1,58 @@
+#include <assert.h>
+#include <js.h>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  js_object_t object;
+  e = js_create_object(env, object);
+  assert(e == 0);
+
+  js_persistent_t<js_object_t> a;
+  e = js_create_reference(env, object, a);
+  assert(e == 0);
+
+  js_persistent_t<js_object_t> b;
+  e = js_create_reference(env, object, b);
+  assert(e == 0);
+
+  b = std::move(a);
+
+  assert(b.ref != NULL);
+
+  e = js_reset_reference(env, a);
+  assert(e == 0);
+
+  e = js_reset_reference(env, b);
+  assert(e == 0);
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
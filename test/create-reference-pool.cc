@@ -0,0 +1,113 @@
+#include <assert.h>
+#include <js.h>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  js_reference_pool_t pool;
+  e = js_create_reference_pool(env, 2, pool);
+  assert(e == 0);
+
+  js_object_t a;
+  e = js_create_object(env, a);
+  assert(e == 0);
+
+  js_object_t b;
+  e = js_create_object(env, b);
+  assert(e == 0);
+
+  uint32_t x;
+  e = js_create_reference(env, pool, a, x);
+  assert(e == 0);
+
+  uint32_t y;
+  e = js_create_reference(env, pool, b, y);
+  assert(e == 0);
+
+  assert(x != y);
+
+  js_object_t value;
+  e = js_get_reference_value(env, pool, y, value);
+  assert(e == 0);
+
+  bool equals;
+  e = js_strict_equals(env, value, b, &equals);
+  assert(e == 0);
+
+  assert(equals);
+
+  e = js_delete_reference(env, pool, x);
+  assert(e == 0);
+
+  uint32_t z;
+  e = js_create_reference(env, pool, b, z);
+  assert(e == 0);
+
+  assert(z == x);
+
+  e = js_delete_reference(env, pool, z);
+  assert(e == 0);
+
+  e = js_delete_reference(env, pool, z);
+  assert(e == js_pending_exception);
+
+  js_value_t *error;
+  e = js_get_and_clear_last_exception(env, &error);
+  assert(e == 0);
+
+  uint32_t w;
+  e = js_create_reference(env, pool, a, w);
+  assert(e == 0);
+
+  e = js_create_reference(env, pool, b, z);
+  assert(e == 0);
+
+  assert(w != z);
+
+  e = js_reset_reference_pool(env, pool);
+  assert(e == 0);
+
+  e = js_create_reference(env, pool, a, x);
+  assert(e == 0);
+
+  e = js_get_reference_value(env, pool, x, value);
+  assert(e == 0);
+
+  e = js_strict_equals(env, value, a, &equals);
+  assert(e == 0);
+
+  assert(equals);
+
+  e = js_reset_reference_pool(env, pool);
+  assert(e == 0);
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
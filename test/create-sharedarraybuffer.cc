@@ -0,0 +1,85 @@
+#include <assert.h>
+#include <js.h>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  std::span<uint32_t> view;
+  js_sharedarraybuffer_t sharedarraybuffer;
+  e = js_create_sharedarraybuffer(env, 4, view, sharedarraybuffer);
+  assert(e == 0);
+
+  view[2] = 42;
+
+  std::shared_ptr<js_arraybuffer_backing_store_t> backing_store;
+  e = js_get_sharedarraybuffer_backing_store(env, sharedarraybuffer, backing_store);
+  assert(e == 0);
+
+  std::span<uint32_t> shared;
+  js_sharedarraybuffer_t other;
+  e = js_create_sharedarraybuffer(env, backing_store, shared, other);
+  assert(e == 0);
+
+  assert(shared.data() == view.data());
+  assert(shared.size() == 4);
+
+  js_typedarray_t<uint32_t> typedarray;
+  e = js_create_typedarray(env, 2, other, 2 * sizeof(uint32_t), typedarray);
+  assert(e == 0);
+
+  std::span<uint32_t> elements;
+  e = js_get_typedarray_info(env, typedarray, elements);
+  assert(e == 0);
+
+  assert(elements.size() == 2);
+  assert(elements[0] == 42);
+
+  js_value_t *global;
+  e = js_get_global(env, &global);
+  assert(e == 0);
+
+  e = js_set_property(env, js_object_t(global), "buffer", other);
+  assert(e == 0);
+
+  js_sharedarraybuffer_t result;
+  e = js_get_property(env, js_object_t(global), "buffer", result);
+  assert(e == 0);
+
+  std::span<uint32_t> data;
+  e = js_get_sharedarraybuffer_info(env, result, data);
+  assert(e == 0);
+
+  assert(data[2] == 42);
+
+  backing_store.reset();
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
@@ -0,0 +1,102 @@
+#include <assert.h>
+#include <js.h>
+#include <math.h>
+#include <span>
+#include <uv.h>
+#include <vector>
+
+#include "../include/jstl.h"
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  std::vector<double> samples = {0.5, -1.25, 2, 3.75, -4, 5.5, 6.125};
+
+  js_typedarray_t<float> floats;
+  e = js_create_typedarray(env, std::span<const double>(samples), floats);
+  assert(e == 0);
+
+  std::span<float> view;
+  e = js_get_typedarray_info(env, floats, view);
+  assert(e == 0);
+
+  assert(view.size() == samples.size());
+
+  for (size_t i = 0; i < samples.size(); i++) {
+    assert(view[i] == float(samples[i]));
+  }
+
+  std::vector<int32_t> levels = {-5, 300, 128, 0, 255, 1000, -1, 42, 7};
+
+  js_typedarray_t<uint8_t> clamped;
+  e = js_create_typedarray<uint8_t, true>(env, std::span<const int32_t>(levels), clamped);
+  assert(e == 0);
+
+  std::span<uint8_t> bytes;
+  e = js_get_typedarray_info(env, clamped, bytes);
+  assert(e == 0);
+
+  assert(bytes[0] == 0);
+  assert(bytes[1] == 255);
+  assert(bytes[2] == 128);
+  assert(bytes[5] == 255);
+  assert(bytes[8] == 7);
+
+  std::vector<uint16_t> network = {0x0102, 0x0304, 0x0506};
+
+  js_typedarray_t<uint16_t> swapped;
+  e = js_create_typedarray<uint16_t, false, std::endian::big>(env, std::span<const uint16_t>(network), swapped);
+  assert(e == 0);
+
+  std::span<uint16_t> words;
+  e = js_get_typedarray_info(env, swapped, words);
+  assert(e == 0);
+
+  if constexpr (std::endian::native == std::endian::little) {
+    assert(words[0] == 0x0201);
+    assert(words[2] == 0x0605);
+  }
+
+  std::vector<double> edges = {NAN, -INFINITY, -1.5, 4294967297.0, 2147483648.0};
+
+  js_typedarray_t<int32_t> wrapped;
+  e = js_create_typedarray<int32_t>(env, std::span<const double>(edges), wrapped);
+  assert(e == 0);
+
+  std::span<int32_t> integers;
+  e = js_get_typedarray_info(env, wrapped, integers);
+  assert(e == 0);
+
+  assert(integers[0] == 0);
+  assert(integers[1] == 0);
+  assert(integers[2] == -1);
+  assert(integers[3] == 1);
+  assert(integers[4] == -2147483647 - 1);
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
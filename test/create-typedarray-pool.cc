@@ -0,0 +1,114 @@
+#include <assert.h>
+#include <js.h>
+#include <span>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  js_typedarray_pool_t pool(64, 32);
+
+  std::vector<uint8_t> hash(24, 42);
+
+  js_typedarray_t<uint8_t> a;
+  e = js_create_typedarray(env, pool, hash, a);
+  assert(e == 0);
+
+  js_typedarray_t<uint8_t> b;
+  e = js_create_typedarray(env, pool, hash, b);
+  assert(e == 0);
+
+  js_typedarray_t<uint8_t> c;
+  e = js_create_typedarray(env, pool, hash, c);
+  assert(e == 0);
+
+  js_arraybuffer_t arraybuffer_a, arraybuffer_b, arraybuffer_c;
+  std::span<uint8_t> view;
+  size_t offset;
+
+  e = js_get_typedarray_info(env, a, view, arraybuffer_a, offset);
+  assert(e == 0);
+
+  assert(offset == 0);
+  assert(view.size() == 24);
+  assert(view[23] == 42);
+
+  e = js_get_typedarray_info(env, b, view, arraybuffer_b, offset);
+  assert(e == 0);
+
+  assert(offset == 24);
+
+  e = js_get_typedarray_info(env, c, view, arraybuffer_c, offset);
+  assert(e == 0);
+
+  assert(offset == 0);
+
+  bool equals;
+  e = js_strict_equals(env, arraybuffer_a.value, arraybuffer_b.value, &equals);
+  assert(e == 0);
+
+  assert(equals);
+
+  e = js_strict_equals(env, arraybuffer_a.value, arraybuffer_c.value, &equals);
+  assert(e == 0);
+
+  assert(!equals);
+
+  std::span<uint32_t> large;
+  js_typedarray_t<uint32_t> d;
+  e = js_create_typedarray(env, pool, 16, large, d);
+  assert(e == 0);
+
+  e = js_get_typedarray_info(env, d, large, arraybuffer_a, offset);
+  assert(e == 0);
+
+  assert(offset == 0);
+  assert(large.size() == 16);
+
+  e = js_detach_arraybuffer(env, arraybuffer_c);
+  assert(e == 0);
+
+  js_typedarray_t<uint8_t> f;
+  e = js_create_typedarray(env, pool, hash, f);
+  assert(e == 0);
+
+  e = js_get_typedarray_info(env, f, view, arraybuffer_a, offset);
+  assert(e == 0);
+
+  assert(offset == 0);
+  assert(view[0] == 42);
+
+  e = js_reset_typedarray_pool(env, pool);
+  assert(e == 0);
+
+  assert(pool.data == nullptr);
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
@@ -0,0 +1,67 @@
+#include <assert.h>
+#include <js.h>
+#include <span>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  std::span<uint16_t> view;
+  js_typedarray_t<uint16_t> typedarray;
+  e = js_create_unsafe_typedarray(env, 4, view, typedarray);
+  assert(e == 0);
+
+  assert(view.size() == 4);
+
+  for (size_t i = 0; i < view.size(); i++) {
+    view[i] = uint16_t(i * 3);
+  }
+
+  std::span<uint16_t> elements;
+  e = js_get_typedarray_info(env, typedarray, elements);
+  assert(e == 0);
+
+  assert(elements.size() == 4);
+  assert(elements[3] == 9);
+
+  uint8_t *data;
+  js_arraybuffer_t arraybuffer;
+  e = js_create_unsafe_arraybuffer(env, 8, data, arraybuffer);
+  assert(e == 0);
+
+  std::span<uint8_t> bytes;
+  e = js_get_arraybuffer_info(env, arraybuffer, bytes);
+  assert(e == 0);
+
+  assert(bytes.size() == 8);
+  assert(bytes.data() == data);
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
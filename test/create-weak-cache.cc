@@ -0,0 +1,93 @@
+#include <assert.h>
+#include <js.h>
+#include <optional>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+struct native_t {
+  int value;
+};
+
+static int created = 0;
+
+static int
+on_create(js_env_t *env, native_t *, js_object_t &result) {
+  created++;
+
+  return js_create_object(env, result);
+}
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  native_t native = {42};
+
+  js_weak_cache_t<native_t *, js_object_t> cache;
+
+  std::optional<js_object_t> missing;
+  e = js_get_weak_cache_value(env, cache, &native, missing);
+  assert(e == 0);
+
+  assert(!missing.has_value());
+
+  js_object_t a;
+  e = js_get_weak_cache_value(env, cache, &native, on_create, a);
+  assert(e == 0);
+
+  js_object_t b;
+  e = js_get_weak_cache_value(env, cache, &native, on_create, b);
+  assert(e == 0);
+
+  assert(created == 1);
+
+  bool equals;
+  e = js_strict_equals(env, a, b, &equals);
+  assert(e == 0);
+
+  assert(equals);
+
+  e = js_set_weak_cache_value(env, cache, &native, a);
+  assert(e == 0);
+
+  std::optional<js_object_t> c;
+  e = js_get_weak_cache_value(env, cache, &native, c);
+  assert(e == 0);
+
+  assert(c.has_value());
+
+  e = js_strict_equals(env, a, *c, &equals);
+  assert(e == 0);
+
+  assert(equals);
+
+  e = js_delete_weak_cache_value(env, cache, &native);
+  assert(e == 0);
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
@@ -0,0 +1,100 @@
+#include <assert.h>
+#include <js.h>
+#include <stdint.h>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+struct base_t {
+  int32_t padding = 1;
+
+  virtual ~base_t() = default;
+};
+
+struct value_t {
+  int32_t value = 0;
+
+  int32_t
+  get() const {
+    return value;
+  }
+
+  void
+  set(int32_t n) {
+    value = n;
+  }
+
+  int32_t
+  add(int32_t n) {
+    return value += n;
+  }
+};
+
+struct derived_t : base_t, value_t {};
+
+derived_t *
+on_construct() {
+  return new derived_t();
+}
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  js_class_t<derived_t> derived;
+  e = js_define_class<derived_t, on_construct>(
+    env,
+    "Derived",
+    derived,
+    js_class_method_t<&derived_t::add>("add"),
+    js_class_accessor_t<&derived_t::get, &derived_t::set>("value")
+  );
+  assert(e == 0);
+
+  js_object_t global;
+  e = js_get_global(env, global);
+  assert(e == 0);
+
+  e = js_set_property(env, global, "Derived", derived);
+  assert(e == 0);
+
+  js_string_t source;
+  e = js_create_string(env, "const d = new Derived(); d.value = 40; d.add(2)", source);
+  assert(e == 0);
+
+  js_handle_t result;
+  e = js_run_script(env, source, result);
+  assert(e == 0);
+
+  int32_t value;
+  e = js_get_value_int32(env, result, &value);
+  assert(e == 0);
+
+  assert(value == 42);
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
@@ -0,0 +1,97 @@
+#include <assert.h>
+#include <js.h>
+#include <stdint.h>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+struct counter_t {
+  int32_t value = 0;
+
+  int32_t
+  increment(int32_t n) {
+    return value += n;
+  }
+};
+
+struct other_t {
+  double value = 0;
+};
+
+counter_t *
+on_construct_counter() {
+  return new counter_t();
+}
+
+other_t *
+on_construct_other() {
+  return new other_t();
+}
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  js_class_t<counter_t> counter;
+  e = js_define_class<counter_t, on_construct_counter>(
+    env,
+    "Counter",
+    counter,
+    js_class_method_t<&counter_t::increment>("increment")
+  );
+  assert(e == 0);
+
+  js_class_t<other_t> other;
+  e = js_define_class<other_t, on_construct_other>(env, "Other", other);
+  assert(e == 0);
+
+  js_object_t global;
+  e = js_get_global(env, global);
+  assert(e == 0);
+
+  e = js_set_property(env, global, "Counter", counter);
+  assert(e == 0);
+
+  e = js_set_property(env, global, "Other", other);
+  assert(e == 0);
+
+  js_string_t source;
+  e = js_create_string(env, "const rejects = (fn) => { try { fn(); return false } catch (err) { return err instanceof TypeError } }; rejects(() => Counter.prototype.increment.call(new Other(), 1)) && rejects(() => Counter.prototype.increment.call({}, 1)) && rejects(() => Counter()) && new Counter().increment(2) === 2", source);
+  assert(e == 0);
+
+  js_handle_t result;
+  e = js_run_script(env, source, result);
+  assert(e == 0);
+
+  bool value;
+  e = js_get_value_bool(env, result, &value);
+  assert(e == 0);
+
+  assert(value);
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
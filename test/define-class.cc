@@ -0,0 +1,100 @@
+#include <assert.h>
+#include <js.h>
+#include <stdint.h>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+struct counter_t {
+  int32_t value;
+
+  counter_t(int32_t value) : value(value) {}
+
+  int32_t
+  increment(int32_t n) {
+    return value += n;
+  }
+
+  int32_t
+  get() const {
+    return value;
+  }
+
+  void
+  set(int32_t n) {
+    value = n;
+  }
+};
+
+counter_t *
+on_construct(int32_t value) {
+  return new counter_t(value);
+}
+
+int32_t
+on_static_call(int32_t n) {
+  return n * 2;
+}
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  js_class_t<counter_t> counter;
+  e = js_define_class<counter_t, on_construct>(
+    env,
+    "Counter",
+    counter,
+    js_class_method_t<&counter_t::increment>("increment"),
+    js_class_accessor_t<&counter_t::get, &counter_t::set>("value"),
+    js_class_static_t<on_static_call>("double")
+  );
+  assert(e == 0);
+
+  js_object_t global;
+  e = js_get_global(env, global);
+  assert(e == 0);
+
+  e = js_set_property(env, global, "Counter", counter);
+  assert(e == 0);
+
+  js_string_t source;
+  e = js_create_string(env, "const c = new Counter(40); c.increment(1); c.value += 1; Counter.double(c.value)", source);
+  assert(e == 0);
+
+  js_handle_t result;
+  e = js_run_script(env, source, result);
+  assert(e == 0);
+
+  int32_t value;
+  e = js_get_value_int32(env, result, &value);
+  assert(e == 0);
+
+  assert(value == 84);
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
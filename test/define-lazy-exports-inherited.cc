@@ -0,0 +1,83 @@
+#include <assert.h>
+#include <js.h>
+#include <stdint.h>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+int32_t
+on_add(int32_t a, int32_t b) {
+  return a + b;
+}
+
+using exports = js_exports_t<
+  js_export_method_t<"add", on_add>>;
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  js_object_t global;
+  e = js_get_global(env, global);
+  assert(e == 0);
+
+  js_object_t inherited;
+  e = js_create_object(env, inherited);
+  assert(e == 0);
+
+  e = js_define_lazy_exports<exports>(env, inherited);
+  assert(e == 0);
+
+  e = js_set_property(env, global, "inherited", inherited);
+  assert(e == 0);
+
+  js_object_t assigned;
+  e = js_create_object(env, assigned);
+  assert(e == 0);
+
+  e = js_define_lazy_exports<exports>(env, assigned);
+  assert(e == 0);
+
+  e = js_set_property(env, global, "assigned", assigned);
+  assert(e == 0);
+
+  js_string_t source;
+  e = js_create_string(env, "const derived = Object.create(inherited); const add = derived.add; const descriptor = Object.getOwnPropertyDescriptor(inherited, 'add'); let ok = !Object.hasOwn(derived, 'add') && 'value' in descriptor && descriptor.value === add && add(1, 2) === 3; const shadow = Object.create(assigned); shadow.add = 1; ok = ok && Object.hasOwn(shadow, 'add') && 'get' in Object.getOwnPropertyDescriptor(assigned, 'add'); assigned.add = 2; ok && assigned.add === 2 && Object.getOwnPropertyDescriptor(assigned, 'add').writable", source);
+  assert(e == 0);
+
+  js_handle_t result;
+  e = js_run_script(env, source, result);
+  assert(e == 0);
+
+  bool value;
+  e = js_get_value_bool(env, result, &value);
+  assert(e == 0);
+
+  assert(value);
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
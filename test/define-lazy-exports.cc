@@ -0,0 +1,67 @@
+#include <assert.h>
+#include <js.h>
+#include <stdint.h>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+int32_t
+on_add(int32_t a, int32_t b) {
+  return a + b;
+}
+
+using exports = js_exports_t<
+  js_export_method_t<"add", on_add>,
+  js_export_value_t<"ANSWER", int32_t(42)>>;
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  js_object_t global;
+  e = js_get_global(env, global);
+  assert(e == 0);
+
+  e = js_define_lazy_exports<exports>(env, global);
+  assert(e == 0);
+
+  js_string_t source;
+  e = js_create_string(env, "'get' in Object.getOwnPropertyDescriptor(globalThis, 'add') && add === add && 'value' in Object.getOwnPropertyDescriptor(globalThis, 'add') ? add(ANSWER, 1) : -1", source);
+  assert(e == 0);
+
+  js_handle_t result;
+  e = js_run_script(env, source, result);
+  assert(e == 0);
+
+  int32_t value;
+  e = js_get_value_int32(env, result, &value);
+  assert(e == 0);
+
+  assert(value == 43);
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
@@ -0,0 +1,88 @@
+#include <assert.h>
+#include <js.h>
+#include <memory>
+#include <thread>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+static void
+on_idle(uv_idle_t *handle) {
+  if (js_backing_store_owner_t::live > 0) return;
+
+  uv_idle_stop(handle);
+
+  uv_stop(handle->loop);
+}
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  js_arraybuffer_t arraybuffer;
+  e = js_create_arraybuffer(env, 4, arraybuffer);
+  assert(e == 0);
+
+  std::shared_ptr<js_arraybuffer_backing_store_t> backing_store;
+  e = js_get_arraybuffer_backing_store(env, arraybuffer, backing_store);
+  assert(e == 0);
+
+  assert(js_backing_store_owner_t::live == 1);
+
+  std::thread thread([backing_store = std::move(backing_store)]() mutable {
+    assert(backing_store.use_count() == 1);
+
+    backing_store.reset();
+
+    assert(js_backing_store_owner_t::live == 1);
+  });
+
+  thread.join();
+
+  uv_idle_t idle;
+  e = uv_idle_init(loop, &idle);
+  assert(e == 0);
+
+  e = uv_idle_start(&idle, on_idle);
+  assert(e == 0);
+
+  uv_run(loop, UV_RUN_DEFAULT);
+
+  assert(js_backing_store_owner_t::live == 0);
+
+  uv_close(reinterpret_cast<uv_handle_t *>(&idle), nullptr);
+
+  std::shared_ptr<js_arraybuffer_backing_store_t> held;
+  e = js_get_arraybuffer_backing_store(env, arraybuffer, held);
+  assert(e == 0);
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  assert(js_backing_store_owner_t::live == 0);
+
+  held.reset();
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
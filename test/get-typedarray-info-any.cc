@@ -0,0 +1,65 @@
+#include <assert.h>
+#include <js.h>
+#include <span>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  js_arraybuffer_t arraybuffer;
+  e = js_create_arraybuffer(env, 32, arraybuffer);
+  assert(e == 0);
+
+  js_typedarray_t<double> typedarray;
+  e = js_create_typedarray(env, 2, arraybuffer, 8, typedarray);
+  assert(e == 0);
+
+  js_typedarray_any_t any(typedarray.value);
+
+  js_typedarray_type_t type;
+  std::span<std::byte> view;
+  js_arraybuffer_t buffer;
+  size_t offset;
+  e = js_get_typedarray_info(env, any, type, view, buffer, offset);
+  assert(e == 0);
+
+  assert(type == js_float64array);
+  assert(view.size() == 16);
+  assert(offset == 8);
+
+  std::span<double> elements;
+  e = js_get_typedarray_info(env, typedarray, elements, buffer, offset);
+  assert(e == 0);
+
+  assert(elements.size() == 2);
+  assert((std::byte *) elements.data() == view.data());
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
@@ -0,0 +1,66 @@
+#include <assert.h>
+#include <js.h>
+#include <stdint.h>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+static int32_t count = 0;
+
+int32_t
+on_get(js_env_t *env) {
+  return count;
+}
+
+void
+on_set(js_env_t *env, int32_t value) {
+  count = value;
+}
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  js_object_t object;
+  e = js_create_object(env, object, js_property_t<js_accessor_t<on_get, on_set>>("count"));
+  assert(e == 0);
+
+  e = js_set_property(env, object, "count", int32_t(42));
+  assert(e == 0);
+
+  assert(count == 42);
+
+  count++;
+
+  int32_t value;
+  e = js_get_property(env, object, "count", value);
+  assert(e == 0);
+
+  assert(value == 43);
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}